@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stdint.h>
+#include <limits>
+#include <esp32_ui/menu_base.h>
+
+/**
+ * @file accel_curve.h
+ * @brief Velocity-based step acceleration for fields.
+ *
+ * Each nav event carries the time it was dispatched (MenuEvent::timestamp_ms). A field
+ * with an AccelCurve looks at the gap since its previous nav event in the same
+ * direction: slower than slow_ms is a normal step, faster than fast_ms is the full
+ * max_multiplier, and the multiplier ramps up quadratically in between, so fine
+ * adjustments stay fine and a quick spin crosses the whole range in a few dozen
+ * detents. The scaled step still goes through a single apply_delta().
+ */
+
+namespace esp32_ui
+{
+  struct AccelCurve
+  {
+    uint16_t slow_ms = 120;
+    uint16_t fast_ms = 10;
+    uint16_t max_multiplier = 1; // 1 = no acceleration
+
+    constexpr uint16_t multiplier(uint32_t gap_ms) const
+    {
+      if ((max_multiplier <= 1) || (gap_ms >= slow_ms) || (slow_ms <= fast_ms))
+      {
+        return 1;
+      }
+      if (gap_ms <= fast_ms)
+      {
+        return max_multiplier;
+      }
+
+      const uint32_t num = slow_ms - gap_ms;
+      const uint32_t den = slow_ms - fast_ms;
+      return 1 + uint32_t(max_multiplier - 1) * num * num / (den * den);
+    }
+  };
+
+  // Per-field acceleration state
+  class Accelerator
+  {
+    AccelCurve curve;
+    uint32_t last_ms = 0;
+    int8_t last_dir = 0;
+
+  public:
+    void set_curve(const AccelCurve &c)
+    {
+      curve = c;
+      last_dir = 0;
+    }
+    const AccelCurve &get_curve() const { return curve; }
+    bool enabled() const { return curve.max_multiplier > 1; }
+
+    // Scales a base step by the rotation speed. Events without a timestamp, and the
+    // first event after a change of direction, are never accelerated.
+    delta_t scale(delta_t step, const MenuEvent &ev)
+    {
+      if (!enabled() || !ev.timestamp_ms || !step)
+      {
+        return step;
+      }
+
+      const int8_t dir = (step > 0) ? 1 : -1;
+      const uint32_t gap = ev.timestamp_ms - last_ms;
+      const bool same_run = (dir == last_dir);
+      last_ms = ev.timestamp_ms;
+      last_dir = dir;
+
+      if (!same_run)
+      {
+        return step;
+      }
+
+      delta_t scaled = 0;
+      if (__builtin_mul_overflow(step, delta_t(curve.multiplier(gap)), &scaled))
+      {
+        return (dir > 0) ? std::numeric_limits<delta_t>::max() : -std::numeric_limits<delta_t>::max();
+      }
+      return scaled;
+    }
+  };
+
+} // namespace esp32_ui
@@ -2,6 +2,8 @@
 
 #include <set>
 #include <esp32_ui/element.h>
+#include <esp32_ui/budget.h>
+#include <esp32_ui/event_router.h>
 
 namespace esp32_ui
 {
@@ -34,7 +36,12 @@ namespace esp32_ui
         print_event(ev);
         if (func)
         {
-          func();
+          {
+            UI_BUDGET(Callback, label);
+            func();
+          }
+          // The action may have changed values shown on other menu levels
+          MenuStack::bump_sync_generation();
         }
         return true;
       }
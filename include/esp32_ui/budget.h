@@ -0,0 +1,110 @@
+#pragma once
+
+/**
+ * @file budget.h
+ * @brief Execution-time budgets for user callbacks and UI phases.
+ *
+ * Build with -DESP32_UI_EXEC_BUDGETS to enable. Without it, UI_BUDGET() expands to
+ * nothing and none of this is compiled.
+ *
+ * UI_BUDGET(kind, label) times the rest of the enclosing scope. If it takes longer
+ * than the budget set for that kind, an overrun record (kind, node label, the event
+ * being dispatched, elapsed and budgeted microseconds) goes into a bounded log of the
+ * last ESP32_UI_BUDGET_LOG overruns, which can be read back at runtime:
+ *
+ *   ExecBudget::set_budget(BudgetKind::Setter, 100);
+ *   ...
+ *   BudgetOverrun log[8];
+ *   size_t n = ExecBudget::read_overruns(log, 8);
+ *
+ * The library wraps Bang/ToggleElement funcs, field getters and setters, on_enter_cb
+ * and on_exit_cb, and the dispatch, sync and draw phases of the UI tasks. Draw-phase
+ * records carry the most recently dispatched event.
+ */
+
+#ifdef ESP32_UI_EXEC_BUDGETS
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <esp32_ui/menu_event.h>
+
+#ifndef ESP32_UI_BUDGET_LOG
+#define ESP32_UI_BUDGET_LOG 32
+#endif
+
+namespace esp32_ui
+{
+  enum class BudgetKind : uint8_t
+  {
+    Callback, // Bang / ToggleElement func
+    Getter,
+    Setter,
+    Enter, // on_enter_cb
+    Exit,  // on_exit_cb
+    Dispatch,
+    Sync,
+    Draw,
+    NUM_KINDS
+  };
+
+  struct BudgetOverrun
+  {
+    BudgetKind kind;
+    const char *label;
+    MenuEvent ev;
+    uint32_t elapsed_us;
+    uint32_t budget_us;
+  };
+
+  class ExecBudget
+  {
+  public:
+    // 0 disables checking for that kind
+    static void set_budget(BudgetKind kind, uint32_t budget_us);
+    static uint32_t get_budget(BudgetKind kind);
+
+    // Called by the dispatcher, so overruns can name the event that caused them
+    static void set_current_event(const MenuEvent &ev);
+
+    static void check(BudgetKind kind, const char *label, uint32_t elapsed_us);
+
+    // Copies up to max_records of the logged overruns, oldest first
+    static size_t read_overruns(BudgetOverrun *out, size_t max_records);
+    // Overruns since the last clear(), including ones that fell out of the log
+    static uint32_t overrun_count();
+    static void clear();
+
+    static const char *kind_to_str(BudgetKind kind);
+  };
+
+  class BudgetScope
+  {
+    BudgetKind kind;
+    const char *label;
+    uint32_t start_us;
+
+  public:
+    BudgetScope(BudgetKind kind, const char *label)
+        : kind(kind),
+          label(label),
+          start_us(micros())
+    {
+    }
+
+    ~BudgetScope()
+    {
+      ExecBudget::check(kind, label, micros() - start_us);
+    }
+  };
+
+} // namespace esp32_ui
+
+#define UI_BUDGET_CAT_(a, b) a##b
+#define UI_BUDGET_CAT(a, b) UI_BUDGET_CAT_(a, b)
+#define UI_BUDGET(kind, label) ::esp32_ui::BudgetScope UI_BUDGET_CAT(_ui_budget_, __LINE__)(::esp32_ui::BudgetKind::kind, label)
+
+#else
+
+#define UI_BUDGET(kind, label)
+
+#endif
@@ -2,6 +2,7 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include <atomic>
 #include <type_traits>
 #include <vector>
 #include <memory>
@@ -10,16 +11,25 @@
 #include <esp32_ui/element.h>
 #include <esp32_ui/menu_event.h>
 #include <esp32_ui/widget.h>
+#include <esp32_ui/layout.h>
 
 namespace esp32_ui
 {
   class Canvas : public Element
   {
   protected:
-    int8_t cursor = 0;
+    std::atomic<int8_t> cursor{0}; // Moved by the dispatch task, read by the display task
     bool fixed_cursor = false;
 
     std::vector<std::unique_ptr<Widget>> widgets;
+
+    // One rectangle per visible row slot, refreshed by update_layout()
+    inline static constexpr uint8_t ROW_PITCH = 12;
+    inline static constexpr uint8_t FIXED_CURSOR_ROW_PITCH = 8;
+    mutable std::vector<RowRect> rows;
+    mutable LayoutStamp layout_stamp;
+    void update_layout(Display *d) const;
+
     virtual int8_t selected_index() const { return cursor; }
 
     std::unique_ptr<Header> u_hdr = nullptr;
@@ -49,9 +59,18 @@ namespace esp32_ui
     Widget *c_current_widget() const;
     Widget *active_widget();
     void move_cursor(const MenuEvent &ev);
+
+    int8_t get_cursor() const { return selected_index(); }
+    size_t num_widgets() const { return widgets.size(); }
+    Widget *widget_at(size_t i) const { return (i < widgets.size()) ? widgets[i].get() : nullptr; }
+
+    // Moves the cursor without any focus changes, for use while the Canvas isn't the
+    // top menu (handle_enter() focuses whatever the cursor points at)
+    bool set_cursor(size_t i);
     void set_fixed_cursor(bool on_off = true)
     {
       fixed_cursor = on_off;
+      layout_stamp.invalidate();
     }
     /////////////////////////////////////////////////////////////////////////////
     // NAVIGATION FUNCTIONS
@@ -72,6 +91,7 @@ namespace esp32_ui
     virtual bool handle_nav_back(const MenuEvent &ev) override;
 
     virtual void handle_enter() override;
+    virtual void handle_resume() override;
     virtual void handle_exit() override;
   };
 
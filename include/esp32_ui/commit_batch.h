@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <esp32_ui/element.h>
+
+/**
+ * @file commit_batch.h
+ * @brief Collect field commits into one batch callback.
+ *
+ * Normally every commit reaches the application through that field's own setter,
+ * one call at a time. Once a batch handler is registered, commits made inside a
+ * CommitTransaction by fields that have a field id are collected as
+ * (field id, type, value) records instead, and handed over in a single call when
+ * the outermost transaction ends. The application can apply the whole batch under
+ * one lock, so it lands in the same audio block.
+ *
+ * The event dispatch task opens a transaction around each batch of queued events,
+ * so a WidgetPair edit or any other multi-field commit arrives together. Page-level
+ * actions ("save page", FieldStore::commit_all()) can open their own:
+ *
+ *   {
+ *     CommitTransaction txn;
+ *     store.commit_all();
+ *   } // <-- batch handler runs here
+ *
+ * Fields without an id (the default) and commits made outside a transaction, or
+ * from a task other than the one that opened it, still go to their setters.
+ *
+ * A later commit to the same field replaces the earlier record, except for delta
+ * records (a SockPuppet in EditMode::Delta), which are added up so no step is lost.
+ */
+
+namespace esp32_ui
+{
+  class CommitBatch
+  {
+  public:
+    struct Record
+    {
+      uint16_t field_id;
+      Element::FieldDataType type;
+      int64_t value; // What the field's setter would have received
+      bool delta;    // value is a change to apply, not the new value
+    };
+
+    using Handler = std::function<void(const Record *records, size_t count)>;
+
+    // Meyers singleton
+    static CommitBatch *instance();
+
+    // Register before UIManager::start_ui(); nullptr goes back to per-field setters
+    void set_handler(Handler h) { handler = std::move(h); }
+    bool has_handler() const { return static_cast<bool>(handler); }
+
+    // Transactions nest; only the outermost end() delivers the batch. begin()
+    // returns false (and end() must not be called) when no handler is registered.
+    bool begin();
+    void end();
+
+    // Captures a commit if the calling task has a transaction open. Returns false if
+    // the caller should call its setter as usual. A later commit to the same field
+    // in the same batch replaces the earlier one, or with delta set, is added to it.
+    // O(1) per commit.
+    bool record(uint16_t field_id, Element::FieldDataType type, int64_t value, bool delta = false);
+
+    size_t pending() const { return records.size(); }
+
+  private:
+    CommitBatch()
+    {
+      records.reserve(16);
+      slots.reserve(16);
+    }
+
+    Handler handler;
+    std::mutex txn_mutex;
+    std::atomic<TaskHandle_t> owner{nullptr};
+    uint8_t depth = 0;
+    std::vector<Record> records;
+    std::unordered_map<uint16_t, uint16_t> slots; // field id -> index in records
+  };
+
+  class CommitTransaction
+  {
+    bool active;
+
+  public:
+    CommitTransaction()
+        : active(CommitBatch::instance()->begin())
+    {
+    }
+
+    ~CommitTransaction()
+    {
+      if (active)
+      {
+        CommitBatch::instance()->end();
+      }
+    }
+
+    CommitTransaction(const CommitTransaction &) = delete;
+    CommitTransaction &operator=(const CommitTransaction &) = delete;
+  };
+
+} // namespace esp32_ui
@@ -1,7 +1,11 @@
 #pragma once
 
+#if defined(DISPLAY_BASE)
 #include <U8g2lib.h>
+#endif
 #include <stdint.h>
+#include <utility>
+#include <esp32_ui/display_backend.h>
 
 /**
  * @file display.h
@@ -23,17 +27,62 @@
 
 // Must be defined in the consuming project before including this file:
 // #define DISPLAY_BASE U8G2_SH1106_128X64_WINSTAR_F_4W_HW_SPI
-#ifndef DISPLAY_BASE
-#error "DISPLAY_BASE must be defined before including display.h. Define it in your project."
+//
+// Optionally also define DISPLAY_WIDTH and DISPLAY_HEIGHT (e.g. 128 and 32) to make the
+// panel geometry a compile-time constant. Host builds without a panel can define
+// DISPLAY_MEMORY_BACKEND instead of DISPLAY_BASE to render into memory.
+//
+// Define ESP32_UI_PAGE_BUFFER when DISPLAY_BASE is a page-buffer driver (the _1_ or _2_
+// variants, e.g. U8G2_SSD1306_128X64_NONAME_1_HW_I2C). The display task then renders
+// with firstPage()/nextPage(), drawing only the Canvas rows that fall on each page.
+// A 128x64 panel needs 128 bytes of buffer instead of 1 KB, in exchange for walking
+// the menu once per page. The screen saver effects and the DisplayMirror need the
+// whole frame and are skipped in this mode.
+#ifndef DISPLAY_WIDTH
+#define DISPLAY_WIDTH 0
+#endif
+
+#ifndef DISPLAY_HEIGHT
+#define DISPLAY_HEIGHT 0
 #endif
 
 namespace esp32_ui
 {
-  class Display : public DISPLAY_BASE
+  using DisplayGeometry = PanelGeometry<DISPLAY_WIDTH, DISPLAY_HEIGHT>;
+
+#if defined(DISPLAY_BASE)
+  using DisplayDriver = DISPLAY_BASE;
+#elif defined(DISPLAY_MEMORY_BACKEND)
+  static_assert(DisplayGeometry::is_static, "DISPLAY_MEMORY_BACKEND needs DISPLAY_WIDTH and DISPLAY_HEIGHT");
+  using DisplayDriver = MemoryBackend<DisplayGeometry>;
+#else
+#error "DISPLAY_BASE must be defined before including display.h. Define it in your project."
+#endif
+
+  class Display : public DisplayDriver
   {
     Display(); // Implementation must be defined by the consuming project
 
   public:
+    /**
+     * @brief Another panel with the same driver, for a menu DisplayPort (see
+     * display_registry.h). Arguments go to the driver's constructor; instance() stays
+     * the primary panel.
+     */
+    template <typename... Args>
+    explicit Display(Args &&...args)
+        : DisplayDriver(std::forward<Args>(args)...)
+    {
+    }
+
+    using geometry = DisplayGeometry;
+
+#ifdef ESP32_UI_PAGE_BUFFER
+    inline static constexpr bool page_buffered = true;
+#else
+    inline static constexpr bool page_buffered = false;
+#endif
+
     /**
      * @brief Initializes the display hardware.
      * Call once during startup before drawing.
@@ -50,14 +99,101 @@ namespace esp32_ui
     }
 
     /**
-     * @brief Returns the fixed-width character width in pixels.
+     * @brief Panel size; constant-folded when DISPLAY_WIDTH/DISPLAY_HEIGHT are defined.
      */
-    uint8_t char_width() const { return 8; }
+    uint16_t getWidth()
+    {
+      if constexpr (geometry::is_static)
+      {
+        return geometry::width;
+      }
+      else
+      {
+        return DisplayDriver::getWidth();
+      }
+    }
+
+    uint16_t getHeight()
+    {
+      if constexpr (geometry::is_static)
+      {
+        return geometry::height;
+      }
+      else
+      {
+        return DisplayDriver::getHeight();
+      }
+    }
+
+    uint8_t getBufferTileWidth()
+    {
+      if constexpr (geometry::is_static)
+      {
+        return geometry::tile_width;
+      }
+      else
+      {
+        return DisplayDriver::getBufferTileWidth();
+      }
+    }
+
+    /**
+     * @brief First panel row held by the buffer: the current page's top in page-buffer
+     * mode, 0 otherwise.
+     */
+    uint16_t buffer_top() { return uint16_t(getBufferCurrTileRow()) * 8; }
+
+    /**
+     * @brief True if any of panel rows [y, y + h) are in the buffer being drawn.
+     * Always true for a full-buffer driver.
+     */
+    bool rows_in_buffer(uint16_t y, uint16_t h)
+    {
+      const uint16_t top = buffer_top();
+      return (y < top + uint16_t(getBufferTileHeight()) * 8) && (y + h > top);
+    }
+
+    /**
+     * @brief Font currently selected with setFont(), or nullptr before start_display().
+     */
+    const uint8_t *current_font()
+    {
+#if defined(DISPLAY_BASE)
+      return getU8g2()->font;
+#else
+      return getFont();
+#endif
+    }
+
+    /**
+     * @brief Horizontal advance of one glyph in the current font (0 if it's missing).
+     * Uncached; go through FontMetrics for anything on the draw path.
+     */
+    int8_t glyph_advance(uint16_t encoding)
+    {
+#if defined(DISPLAY_BASE)
+      return u8g2_GetGlyphWidth(getU8g2(), encoding);
+#else
+      const char s[2] = {char(encoding), 0};
+      return getStrWidth(s);
+#endif
+    }
+
+    /**
+     * @brief Returns the widest glyph advance of the current font in pixels (the cell
+     * width of a monospace font). See font_metrics.h for measuring actual text.
+     */
+    uint8_t char_width() const;
 
     /**
      * @brief Returns half of the display width in pixels (useful for centering).
      */
-    uint8_t half_width() const { return instance()->getWidth() / 2; }
+    uint8_t half_width() const { return const_cast<Display *>(this)->getWidth() / 2; }
   };
 
+#if defined(DISPLAY_MEMORY_BACKEND) && !defined(DISPLAY_BASE)
+  inline Display::Display() {}
+  inline void Display::start_display() { begin(); }
+#endif
+
 } // namespace esp32_ui
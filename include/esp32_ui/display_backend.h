@@ -0,0 +1,253 @@
+#pragma once
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#if defined(DISPLAY_BASE)
+#include <Arduino.h>
+#endif
+
+/**
+ * @file display_backend.h
+ * @brief Panel geometry and the in-memory panel backend for Display.
+ *
+ * PanelGeometry<W, H> describes the panel at compile time (PanelGeometry<128, 32>,
+ * PanelGeometry<128, 64>, ...), so Display's width/height/tile queries become
+ * constants the compiler can fold. PanelGeometry<> (RuntimeGeometry) keeps asking the
+ * driver at run time.
+ *
+ * MemoryBackend<Geometry> is a plain in-memory panel with the U8g2 drawing API the
+ * library uses, laid out exactly like a U8g2 full buffer. It needs no hardware, so
+ * it can sit next to a real panel in the same binary (off-screen rendering, frame
+ * comparisons) or stand in for the panel on a host build. Without DISPLAY_BASE it
+ * needs neither U8g2 nor the Arduino core, and prints through PrintBase below.
+ */
+
+namespace esp32_ui
+{
+  template <uint16_t W = 0, uint16_t H = 0>
+  struct PanelGeometry
+  {
+    static_assert((W % 8 == 0) && (H % 8 == 0), "Panel dimensions must be multiples of 8");
+
+    inline static constexpr bool is_static = (W != 0) && (H != 0);
+    inline static constexpr uint16_t width = W;
+    inline static constexpr uint16_t height = H;
+    inline static constexpr uint8_t tile_width = W / 8;
+    inline static constexpr uint8_t tile_height = H / 8;
+    inline static constexpr size_t buffer_size = size_t(W) * H / 8;
+  };
+
+  using RuntimeGeometry = PanelGeometry<>;
+
+#if defined(DISPLAY_BASE)
+  using PrintBase = ::Print;
+#else
+  // The part of Arduino's Print the library draws text with, for host builds
+  class PrintBase
+  {
+  public:
+    virtual ~PrintBase() = default;
+    virtual size_t write(uint8_t c) = 0;
+
+    size_t write(const uint8_t *buf, size_t n)
+    {
+      size_t out = 0;
+      while (n--)
+      {
+        out += write(*buf++);
+      }
+      return out;
+    }
+
+    size_t print(const char *s) { return s ? write(reinterpret_cast<const uint8_t *>(s), strlen(s)) : 0; }
+    size_t print(char c) { return write(uint8_t(c)); }
+    size_t print(int v) { return print((long long)v); }
+    size_t print(unsigned int v) { return print((unsigned long long)v); }
+    size_t print(long v) { return print((long long)v); }
+    size_t print(unsigned long v) { return print((unsigned long long)v); }
+
+    size_t print(long long v)
+    {
+      char s[24];
+      snprintf(s, sizeof(s), "%lld", v);
+      return print(s);
+    }
+
+    size_t print(unsigned long long v)
+    {
+      char s[24];
+      snprintf(s, sizeof(s), "%llu", v);
+      return print(s);
+    }
+
+    size_t print(double v, int digits = 2)
+    {
+      char s[32];
+      snprintf(s, sizeof(s), "%.*f", digits, v);
+      return print(s);
+    }
+  };
+#endif
+
+  template <class Geometry>
+  class MemoryBackend : public PrintBase
+  {
+    static_assert(Geometry::is_static, "MemoryBackend needs a compile-time PanelGeometry");
+
+  public:
+    // Fixed glyph cell; text is stood in for by the character code drawn as a bit
+    // column, so different strings still produce different frames
+    inline static constexpr uint8_t GLYPH_WIDTH = 6;
+    inline static constexpr uint8_t GLYPH_HEIGHT = 10;
+
+    MemoryBackend() = default;
+
+    void begin() { clearBuffer(); }
+    void clearBuffer() { memset(buffer, 0, sizeof(buffer)); }
+    void sendBuffer() { ++frames; }
+    void firstPage() { clearBuffer(); }
+    uint8_t nextPage()
+    {
+      sendBuffer();
+      return 0;
+    }
+
+    uint8_t *getBufferPtr() { return buffer; }
+    uint8_t getBufferTileWidth() { return Geometry::tile_width; }
+    uint8_t getBufferTileHeight() { return Geometry::tile_height; }
+    uint8_t getBufferCurrTileRow() { return 0; }
+    void setBufferCurrTileRow(uint8_t) {}
+    uint32_t frames_sent() const { return frames; }
+
+    uint16_t getWidth() { return Geometry::width; }
+    uint16_t getHeight() { return Geometry::height; }
+    uint16_t getDisplayWidth() { return Geometry::width; }
+    uint16_t getDisplayHeight() { return Geometry::height; }
+
+    void setCursor(uint16_t x, uint16_t y)
+    {
+      cursor_x = x;
+      cursor_y = y;
+    }
+    uint16_t getCursorX() { return cursor_x; }
+    uint16_t getCursorY() { return cursor_y; }
+
+    void setDrawColor(uint8_t c) { color = c; }
+    uint8_t getDrawColor() { return color; }
+
+    void setFont(const uint8_t *f) { font = f; }
+    const uint8_t *getFont() const { return font; }
+    void setFontRefHeightExtendedText() {}
+    void setFontPosTop() {}
+    void setFontDirection(uint8_t) {}
+    int8_t getMaxCharHeight() { return GLYPH_HEIGHT; }
+    int8_t getMaxCharWidth() { return GLYPH_WIDTH; }
+    int8_t getAscent() { return GLYPH_HEIGHT - 2; }
+    int8_t getDescent() { return -2; }
+    uint16_t getStrWidth(const char *s) { return s ? strlen(s) * GLYPH_WIDTH : 0; }
+    uint16_t getUTF8Width(const char *s) { return getStrWidth(s); }
+
+    void drawPixel(uint16_t x, uint16_t y)
+    {
+      if ((x >= Geometry::width) || (y >= Geometry::height))
+      {
+        return;
+      }
+
+      uint8_t &b = buffer[(y >> 3) * Geometry::width + x];
+      const uint8_t bit = 1 << (y & 7);
+      if (color == 0)
+      {
+        b &= ~bit;
+      }
+      else if (color == 1)
+      {
+        b |= bit;
+      }
+      else
+      {
+        b ^= bit;
+      }
+    }
+
+    void drawHLine(uint16_t x, uint16_t y, uint16_t w)
+    {
+      for (uint16_t i = 0; i < w; ++i)
+      {
+        drawPixel(x + i, y);
+      }
+    }
+
+    void drawVLine(uint16_t x, uint16_t y, uint16_t h)
+    {
+      for (uint16_t i = 0; i < h; ++i)
+      {
+        drawPixel(x, y + i);
+      }
+    }
+
+    void drawBox(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      for (uint16_t i = 0; i < h; ++i)
+      {
+        drawHLine(x, y + i, w);
+      }
+    }
+
+    void drawFrame(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      if (!w || !h)
+      {
+        return;
+      }
+      drawHLine(x, y, w);
+      drawHLine(x, y + h - 1, w);
+      drawVLine(x, y, h);
+      drawVLine(x + w - 1, y, h);
+    }
+
+    uint16_t drawGlyph(uint16_t x, uint16_t y, uint16_t c)
+    {
+      for (uint8_t bit = 0; bit < 8; ++bit)
+      {
+        if (c & (1 << bit))
+        {
+          drawPixel(x + 1, y + 1 + bit);
+        }
+      }
+      return GLYPH_WIDTH;
+    }
+
+    uint16_t drawStr(uint16_t x, uint16_t y, const char *s)
+    {
+      uint16_t w = 0;
+      for (; s && *s; ++s)
+      {
+        w += drawGlyph(x + w, y, static_cast<uint8_t>(*s));
+      }
+      return w;
+    }
+
+    virtual size_t write(uint8_t c) override
+    {
+      if (c == '\n')
+      {
+        cursor_x = 0;
+        cursor_y += GLYPH_HEIGHT;
+        return 1;
+      }
+      cursor_x += drawGlyph(cursor_x, cursor_y, c);
+      return 1;
+    }
+
+  protected:
+    uint8_t buffer[Geometry::buffer_size] = {};
+    uint16_t cursor_x = 0;
+    uint16_t cursor_y = 0;
+    uint8_t color = 1;
+    const uint8_t *font = nullptr;
+    uint32_t frames = 0;
+  };
+
+} // namespace esp32_ui
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Arduino.h>
+#include <esp32_ui/display.h>
+#include <esp32_ui/menu_event.h>
+
+/**
+ * @file display_mirror.h
+ * @brief Stream the frame buffer over a byte link and accept MenuEvents back.
+ *
+ * After every sendBuffer() the display task hands the buffer to the DisplayMirror,
+ * which sends only the 8x8 tiles that changed since what the receiver last got.
+ * Each tile goes out XOR'd against the receiver's copy, zero bytes suppressed:
+ *
+ *   frame:  0xA5 'F' <len u16> <seq> <tile cols> <tile rows> <n u16> tiles... <sum>
+ *   tile:   <index u16> <mask> <one byte per set mask bit, XOR delta>
+ *   event:  0x5A 'E' <source> <type> <index> <source ^ type ^ index>   (host -> device)
+ *
+ * Multi-byte values are little endian; <len> counts the bytes between it and <sum>,
+ * and <sum> is the low byte of their sum. A frame never exceeds the per-frame byte
+ * budget; tiles that don't fit stay dirty and go out with the next frame, starting
+ * where this one stopped so nothing starves.
+ *
+ * The transport is anything that moves bytes: StreamTransport wraps an Arduino
+ * Stream (UART, USB CDC, WiFiClient); on a host, implement MirrorTransport on top of
+ * a pipe or socket.
+ */
+
+namespace esp32_ui
+{
+  class MirrorTransport
+  {
+  public:
+    virtual ~MirrorTransport() = default;
+
+    virtual size_t write(const uint8_t *data, size_t len) = 0;
+
+    // Bytes that can be written right now without blocking; SIZE_MAX if unknown, in
+    // which case publish() sends up to max_bytes_per_frame
+    virtual size_t writable() { return SIZE_MAX; }
+
+    // Next received byte, or -1 if there isn't one
+    virtual int read() = 0;
+  };
+
+  class StreamTransport : public MirrorTransport
+  {
+    Stream &stream;
+
+  public:
+    StreamTransport(Stream &stream)
+        : stream(stream)
+    {
+    }
+
+    virtual size_t write(const uint8_t *data, size_t len) override { return stream.write(data, len); }
+    // Print::availableForWrite() returns 0 for streams that don't track it (WiFiClient,
+    // for one), so 0 counts as unknown rather than full
+    virtual size_t writable() override
+    {
+      const int n = stream.availableForWrite();
+      return (n > 0) ? size_t(n) : SIZE_MAX;
+    }
+    virtual int read() override { return stream.available() ? stream.read() : -1; }
+  };
+
+  class DisplayMirror
+  {
+  public:
+    inline static constexpr uint8_t FRAME_SYNC = 0xA5;
+    inline static constexpr uint8_t EVENT_SYNC = 0x5A;
+
+    DisplayMirror(MirrorTransport &transport,
+                  uint16_t max_bytes_per_frame = 512,
+                  uint8_t frame_divider = 1);
+
+    // Called by the display task after each sendBuffer()
+    void publish(Display *d);
+
+    // Decode any injected events and pass them to UIManager::dispatch_event()
+    void poll_input();
+
+    // Resend everything, e.g. when a viewer (re)connects
+    void request_full_frame();
+
+    uint32_t bytes_sent() const { return total_bytes; }
+
+  private:
+    MirrorTransport &transport;
+    uint16_t max_bytes;
+    uint8_t divider;
+    uint8_t divider_count = 0;
+    uint8_t seq = 0;
+    uint16_t next_tile = 0;
+    uint32_t total_bytes = 0;
+
+    std::vector<uint8_t> shadow; // What the receiver has
+    std::vector<uint8_t> packet;
+
+    uint8_t rx[6];
+    uint8_t rx_len = 0;
+  };
+
+} // namespace esp32_ui
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <functional>
+#if defined(DISPLAY_BASE)
+#include <U8g2lib.h>
+#endif
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <esp32_ui/display.h>
+
+/**
+ * @file display_registry.h
+ * @brief Every panel the UI draws to, each with its own refresh rate and dirty flag.
+ *
+ * A DisplayPort is one of two kinds:
+ *
+ * - A menu port wraps a Display and shows a node of the menu tree with the normal
+ *   handle_draw() path: either a fixed root (a status Canvas, an overlay, a
+ *   ScopeWidget) or, with no root, whatever is on top of the menu stack. The primary
+ *   panel, Display::instance(), is registered by UIManager as the primary port.
+ *   Menu ports are all drawn by the display task, one after the other. That keeps
+ *   the tree single-reader, and lets panels of the same U8g2 driver type share its
+ *   static frame buffer: each frame is drawn and sent before the next panel starts.
+ *   The display task sends the primary's frame, runs the screen saver and publishes
+ *   the DisplayMirror before draw_menus(), which clobbers that shared buffer.
+ *
+ * - A raw port wraps any U8G2 object and draws through render() on a FreeRTOS task
+ *   of its own, so a slow I2C status panel never holds back a fast SPI one. Raw ports
+ *   need U8g2, so they only exist in DISPLAY_BASE builds.
+ *
+ * Both kinds only redraw once marked dirty, and no more often than refresh_ms.
+ * UIManager::schedule_redraw() marks every menu port; UIManager::request_redraw()
+ * marks every port. Add ports before UIManager::start_ui().
+ *
+ * Panels that show the same Canvas share its cached layout, so give them the same
+ * font, or call Layout::invalidate_all() after switching.
+ */
+
+namespace esp32_ui
+{
+  class Element;
+
+  class DisplayPort
+  {
+  public:
+#if defined(DISPLAY_BASE)
+    // Raw port: render() draws it on the port's own task
+    DisplayPort(U8G2 &panel,
+                const char *name,
+                uint16_t refresh_ms = 100,
+                UBaseType_t priority = 1)
+        : name(name),
+          refresh_ms(refresh_ms ? refresh_ms : 1),
+          priority(priority),
+          panel(&panel)
+    {
+    }
+#endif
+
+    // Menu port: the display task draws root (nullptr: the top of the menu stack)
+    DisplayPort(Display &display,
+                const char *name,
+                Element *root = nullptr,
+                uint16_t refresh_ms = 33)
+        : name(name),
+          refresh_ms(refresh_ms ? refresh_ms : 1),
+          priority(0),
+          display(&display),
+          root(root)
+    {
+    }
+
+    virtual ~DisplayPort() = default;
+
+    // Runs once before the first frame, on the task that draws the port.
+    // Menu ports call Display::start_display(), raw ports U8G2::begin().
+    virtual void begin();
+
+#if defined(DISPLAY_BASE)
+    // Raw ports: draw one frame into the (already cleared) panel buffer
+    virtual void render(U8G2 &panel) {}
+#endif
+
+    void mark_dirty() { dirty.store(true, std::memory_order_release); }
+    bool is_dirty() const { return dirty.load(std::memory_order_acquire); }
+
+    bool is_menu() const { return display != nullptr; }
+    Display *get_display() const { return display; }
+
+    // Switch what a menu port shows; nullptr follows the menu stack
+    void set_root(Element *el)
+    {
+      root.store(el, std::memory_order_release);
+      mark_dirty();
+    }
+    Element *get_root() const { return root.load(std::memory_order_acquire); }
+    // What a menu port draws right now: its root, or the top of the menu stack
+    Element *shown() const;
+
+    uint32_t frames_sent() const { return frames; }
+    const char *get_name() const { return name; }
+
+    // For the task that draws the port: take_frame() takes the dirty flag if the port
+    // is due for a frame at `now`; draw_frame() clears, renders and sends one frame
+    // (page by page with ESP32_UI_PAGE_BUFFER)
+    bool take_frame(TickType_t now);
+    void draw_frame();
+    bool take_dirty() { return dirty.exchange(false, std::memory_order_acq_rel); }
+
+  protected:
+    friend class DisplayRegistry;
+
+    const char *name;
+    uint16_t refresh_ms;
+    UBaseType_t priority;
+#if defined(DISPLAY_BASE)
+    U8G2 *panel = nullptr;
+#endif
+    Display *display = nullptr;
+    std::atomic<Element *> root{nullptr};
+    std::atomic<bool> dirty{true};
+    uint32_t frames = 0;
+    TickType_t last_frame = 0;
+    TaskHandle_t task = nullptr;
+  };
+
+#if defined(DISPLAY_BASE)
+  // Renders through a callback; handy for status lines and overlay layers
+  class CallbackDisplayPort : public DisplayPort
+  {
+    std::function<void(U8G2 &)> draw_cb;
+    std::function<void(U8G2 &)> begin_cb;
+
+  public:
+    CallbackDisplayPort(U8G2 &panel,
+                        const char *name,
+                        std::function<void(U8G2 &)> draw_cb,
+                        uint16_t refresh_ms = 100,
+                        UBaseType_t priority = 1,
+                        std::function<void(U8G2 &)> begin_cb = nullptr)
+        : DisplayPort(panel, name, refresh_ms, priority),
+          draw_cb(std::move(draw_cb)),
+          begin_cb(std::move(begin_cb))
+    {
+    }
+
+    virtual void begin() override
+    {
+      DisplayPort::begin();
+      if (begin_cb)
+      {
+        begin_cb(*panel);
+      }
+    }
+
+    virtual void render(U8G2 &p) override
+    {
+      if (draw_cb)
+      {
+        draw_cb(p);
+      }
+    }
+  };
+#endif
+
+  class DisplayRegistry
+  {
+  public:
+    inline static constexpr size_t MAX_DISPLAYS = 5; // including the primary panel
+
+    // Meyers singleton
+    static DisplayRegistry *instance();
+
+    // Returns the port's id, or -1 if the registry is full or already started
+    int8_t add(DisplayPort *port);
+    DisplayPort *get(uint8_t id) const { return (id < count) ? ports[id] : nullptr; }
+    size_t size() const { return count; }
+
+    // The menu port for Display::instance(); registered by UIManager
+    int8_t set_primary(DisplayPort *port);
+    DisplayPort *primary() const { return primary_port; }
+
+    void mark_dirty(uint8_t id);
+    void mark_all_dirty();
+    void mark_menus_dirty();
+
+    // Spawns one render task per raw port; called from UIManager::start_ui()
+    void start();
+
+    // Display task only: begin() every menu port, then draw the ones (other than
+    // the primary) that are dirty and due
+    void begin_menus();
+    void draw_menus();
+
+  private:
+    static void port_task(void *param);
+
+    std::array<DisplayPort *, MAX_DISPLAYS> ports = {nullptr};
+    size_t count = 0;
+    DisplayPort *primary_port = nullptr;
+    bool started = false;
+  };
+
+} // namespace esp32_ui
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file edit_journal.h
+ * @brief Undo/redo for field edits, kept in a fixed-size ring.
+ *
+ * Every commit that changes a ValueField, SockPuppet or StoredField value is
+ * recorded as (field, old value, new value, time). Values are stored in the field's
+ * raw int64_t form (see NumericCore), so one entry fits every field type. Commits to
+ * the same field less than coalesce_ms apart extend the last entry instead of adding
+ * one, so a whole knob turn with live_update undoes in one step.
+ *
+ * undo() and redo() put the old/new value back through FieldBase::restore_raw(),
+ * which goes through the field's setter (or the open CommitTransaction) like any
+ * other commit, with recording paused. A new edit after an undo drops the redo
+ * history. When the ring is full the oldest entry is overwritten.
+ *
+ * undo() and redo() change field state and run setters, so like any other edit they
+ * must run on the event dispatch task: call them from a Bang or other element
+ * handler, never straight from an input ISR or another task. record() may be
+ * called from anywhere.
+ *
+ * Fields must outlive their journal entries; call clear() before deleting any.
+ */
+
+#ifndef ESP32_UI_JOURNAL_SIZE
+#define ESP32_UI_JOURNAL_SIZE 64
+#endif
+
+#ifndef ESP32_UI_JOURNAL_COALESCE_MS
+#define ESP32_UI_JOURNAL_COALESCE_MS 750
+#endif
+
+namespace esp32_ui
+{
+  class FieldBase;
+
+  class EditJournal
+  {
+  public:
+    struct Entry
+    {
+      FieldBase *field;
+      int64_t old_raw;
+      int64_t new_raw;
+      uint32_t ts_ms; // time of the latest commit folded into this entry
+    };
+
+    // Meyers singleton
+    static EditJournal *instance();
+
+    // Called by the fields' commit(); O(1)
+    void record(FieldBase *field, int64_t old_raw, int64_t new_raw);
+
+    // Dispatch task only (see above)
+    bool undo();
+    bool redo();
+    bool can_undo() const;
+    bool can_redo() const;
+
+    // Entries that can be undone / redone
+    size_t undo_depth() const;
+    size_t redo_depth() const;
+
+    void clear();
+
+    void set_coalesce_ms(uint32_t ms) { coalesce_ms.store(ms, std::memory_order_relaxed); }
+    uint32_t get_coalesce_ms() const { return coalesce_ms.load(std::memory_order_relaxed); }
+
+    // Stops recording while alive (undo/redo, preset loads, anything that restores
+    // state rather than editing it). Nests.
+    class Pause
+    {
+    public:
+      Pause() { instance()->paused.fetch_add(1, std::memory_order_acq_rel); }
+      ~Pause() { instance()->paused.fetch_sub(1, std::memory_order_acq_rel); }
+      Pause(const Pause &) = delete;
+      Pause &operator=(const Pause &) = delete;
+    };
+
+    bool is_recording() const { return paused.load(std::memory_order_acquire) == 0; }
+
+  private:
+    EditJournal() = default;
+
+    inline static constexpr size_t CAPACITY = ESP32_UI_JOURNAL_SIZE;
+    static_assert(CAPACITY > 0, "ESP32_UI_JOURNAL_SIZE must be at least 1");
+
+    Entry &slot(size_t n) { return ring[n % CAPACITY]; }
+
+    mutable std::mutex mutex;
+    std::array<Entry, CAPACITY> ring = {};
+    // Monotonic counters: entries [oldest, cursor) can be undone, [cursor, newest)
+    // redone
+    size_t oldest = 0;
+    size_t cursor = 0;
+    size_t newest = 0;
+    // A coalesced entry may only be extended while it's still the latest edit
+    bool open_entry = false;
+
+    std::atomic<uint32_t> coalesce_ms{ESP32_UI_JOURNAL_COALESCE_MS};
+    std::atomic<uint8_t> paused{0};
+  };
+
+} // namespace esp32_ui
@@ -27,7 +27,9 @@ namespace esp32_ui
       Array_UInt8,
       Array_Int8,
       Array_UInt16,
-      Array_Int16
+      Array_Int16,
+      Float,
+      Fixed // Binary fixed point; values travel as the raw integer
     };
 
     Element(const char *label)
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+
+#include <esp32_ui/menu_event.h>
+
+/**
+ * @file event_lanes.h
+ * @brief Prioritized event queues between dispatch_event() and the dispatch task.
+ *
+ * With a single FIFO, a burst of encoder deltas or Gate events delays a Back or
+ * Select press by the length of the backlog. EventLanes splits the queue into lanes
+ * that are always drained in priority order:
+ *
+ *   Control     Select, Back, button held/released, mode switches, freeze/unfreeze
+ *   Nav         NavUp/Down/Left/Right
+ *   System      Sync, Draw
+ *   BestEffort  whatever sources are mapped to it (Gate by default)
+ *
+ * Each lane has its own bound and drop policy, and its own counters. Since every pop
+ * looks at the Control lane first, a button press is dispatched next no matter how
+ * much nav traffic is queued behind it.
+ */
+
+namespace esp32_ui
+{
+  class EventLanes
+  {
+  public:
+    enum class Lane : uint8_t
+    {
+      Control,
+      Nav,
+      System,
+      BestEffort
+    };
+    inline static constexpr size_t NUM_LANES = 4;
+
+    enum class DropPolicy : uint8_t
+    {
+      DropNewest, // Keep what's queued, refuse the new event
+      DropOldest  // Make room by discarding the oldest queued event
+    };
+
+    struct LaneStats
+    {
+      uint32_t queued;
+      uint32_t dispatched;
+      uint32_t dropped;
+      uint32_t high_water;
+    };
+
+    // Meyers singleton
+    static EventLanes *instance();
+
+    // Lane setup; only takes effect before start()
+    bool configure(Lane lane, uint8_t depth, DropPolicy policy);
+
+    // Route every event from src to a lane, regardless of its type
+    void map_source(MenuEvent::Source src, Lane lane);
+    void unmap_source(MenuEvent::Source src);
+
+    Lane classify(const MenuEvent &ev) const;
+
+    // Creates the queues; called by the dispatch task
+    void start();
+    bool is_started() const { return started.load(std::memory_order_acquire); }
+
+    // Safe from any task. Returns false if the event was dropped.
+    bool push(const MenuEvent &ev);
+
+    // Waits up to `wait` for an event, then returns the oldest event of the highest
+    // priority non-empty lane
+    bool pop(MenuEvent &ev, TickType_t wait);
+
+    // Events queued across all lanes right now
+    size_t pending() const;
+
+    LaneStats stats(Lane lane) const;
+    void reset_stats();
+
+    static const char *lane_to_str(Lane lane);
+
+  private:
+    EventLanes();
+
+    struct LaneState
+    {
+      QueueHandle_t queue = nullptr;
+      uint8_t depth;
+      DropPolicy policy;
+      std::atomic<uint32_t> queued{0};
+      std::atomic<uint32_t> dispatched{0};
+      std::atomic<uint32_t> dropped{0};
+      std::atomic<uint32_t> high_water{0};
+    };
+
+    inline static constexpr uint8_t NO_LANE = 0xFF;
+
+    static uint8_t source_slot(MenuEvent::Source src);
+    bool take_highest(MenuEvent &ev);
+
+    std::array<LaneState, NUM_LANES> lanes;
+    // One entry per Source bit (NoSource + 5 flags)
+    std::array<std::atomic<uint8_t>, 6> source_lane;
+    // Counts queued events across all lanes, so pop() can block on all of them
+    SemaphoreHandle_t available = nullptr;
+    // Published with release once the queues exist; producers on other tasks read it
+    // with acquire before touching them
+    std::atomic<bool> started{false};
+  };
+
+} // namespace esp32_ui
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <unordered_map>
 #include <functional>
 #include <mutex>
+#include <vector>
 
 #include <esp32_ui/menu_event.h>
 #include <esp32_ui/menu_base.h>
@@ -17,31 +20,67 @@ Use MenuStack for:
   Navigating between MenuNodes and FieldNodes
   Routing context-sensitive input like <back>, <select>, encoder rotations
   Fallback event handler
+
+Use bind_realtime() for:
+  Gate and Toggle inputs driving a Bang or ToggleElement (clock, trigger)
+  UIManager::dispatch_event() runs the handler immediately, in the caller's context,
+  without going through the event queue or the menu stack. Keep those handlers short
+  and safe to call from the producer's task. While a bind_popup() for the same input
+  exists, its events are queued instead, so the popup still gets them.
 */
 
+#ifndef ESP32_UI_MENU_DEPTH
+#define ESP32_UI_MENU_DEPTH 8
+#endif
+
 namespace esp32_ui
 {
+  class Bang;
+
+  // Each level remembers where its cursor was and which sync generation its data
+  // came from. The generation moves on whenever model data may have changed (a
+  // committed edit, a Bang/Toggle action, UIManager::request_sync()); coming back to
+  // a level whose generation is still current resumes it instead of re-entering it,
+  // which skips the full re-sync.
   class MenuStack
   {
   public:
+    struct Level
+    {
+      Element *el;
+      int8_t cursor;     // Canvas cursor when the level was left, -1 if not a Canvas
+      uint32_t sync_gen; // 0 = never synced
+    };
+
+    // false if the stack is already max_depth() deep
     bool push(Element *el);
     Element *pop();
     Element *top() const;
     Element *root() const;
+    Level *top_level() { return levels.empty() ? nullptr : &levels.back(); }
 
-    size_t size() const { return depth; }
-    void clear() { depth = 0; }
-    bool empty() const { return depth == 0; }
+    size_t size() const { return levels.size(); }
+    void clear() { levels.clear(); }
+    bool empty() const { return levels.empty(); }
 
-    size_t max_depth() const { return STACK_SIZE; }
-    bool full() const { return depth >= STACK_SIZE; }
+    size_t max_depth() const { return limit; }
+    bool full() const { return levels.size() >= limit; }
+    // Can't drop below the current depth
+    bool set_max_depth(size_t depth);
 
-    MenuStack() = default;
+    MenuStack() { levels.reserve(limit); }
+
+    static uint32_t sync_generation() { return generation.load(std::memory_order_acquire); }
+    static void bump_sync_generation()
+    {
+      uint32_t next = generation.load(std::memory_order_relaxed) + 1;
+      generation.store(next ? next : 1, std::memory_order_release);
+    }
 
   private:
-    inline static constexpr size_t STACK_SIZE = 8;
-    std::array<Element *, STACK_SIZE> stack = {nullptr};
-    size_t depth = 0;
+    std::vector<Level> levels;
+    size_t limit = ESP32_UI_MENU_DEPTH;
+    inline static std::atomic<uint32_t> generation{1};
   };
 
   class EventRouter
@@ -54,6 +93,7 @@ namespace esp32_ui
     // events on queue
     void dispatch(const MenuEvent &ev);
     friend void evt_dispatch_task(void * param);
+    friend class EventReplayer;
 
   public:
     // Meyers singleton
@@ -62,6 +102,10 @@ namespace esp32_ui
     bool bind_popup(MenuEvent::Source src, uint8_t idx, Element *el);
     bool unbind_popup(MenuEvent::Source src, uint8_t idx);
     bool bind(MenuEvent::Source src, uint8_t idx, Element *el);
+    // bind(), plus a realtime slot (see dispatch_realtime()). Only Gate/Toggle inputs
+    // below MAX_REALTIME_INDEX have one; returns false for anything else.
+    bool bind_realtime(MenuEvent::Source src, uint8_t idx, Bang *el);
+    // Also releases a realtime slot, waiting for a handler that's still running
     bool unbind(MenuEvent::Source source, uint8_t idx);
 
     bool push_menu(Element *el);
@@ -71,6 +115,35 @@ namespace esp32_ui
     Element *root_menu() const;
     Element *overwrite_top(Element *el);
 
+    // How many menus deep push_menu() can go (ESP32_UI_MENU_DEPTH by default)
+    bool set_max_menu_depth(size_t depth) { return menu_stack.set_max_depth(depth); }
+    size_t max_menu_depth() const { return menu_stack.max_depth(); }
+
+    // Goes straight to a node anywhere under the root Canvas. path[i] is the widget
+    // index to select at depth i; every step but the last must be a submenu, which is
+    // pushed. With open_last, the last step's submenu is pushed too. The old top gets
+    // handle_exit() and the new top handle_enter(); the levels in between are put on
+    // the stack without entering them. Returns false (and changes nothing) if the
+    // path doesn't resolve or is deeper than the stack. See menu_index.h.
+    bool jump_to(const uint8_t *path, size_t n, bool open_last = false);
+
+    // Gate/Toggle indices below this get a lock-free realtime binding
+    inline static constexpr uint8_t MAX_REALTIME_INDEX = 16;
+
+    struct RealtimeStats
+    {
+      uint32_t count;
+      uint32_t last_us;
+      uint32_t worst_us;
+    };
+
+    // Runs the handler bound with bind_realtime() right away. Returns false (and does
+    // nothing) if there is no such binding or a popup binding overrides it, in which
+    // case the event should be queued as usual. Constant-time lookup, no locks.
+    bool dispatch_realtime(const MenuEvent &ev);
+    RealtimeStats realtime_stats() const;
+    void reset_realtime_stats();
+
   private:
     struct Key
     {
@@ -94,6 +167,21 @@ namespace esp32_ui
     std::array<std::unordered_map<Key, MenuBase *, KeyHash>, 2> bindings;
     std::function<void(MenuEvent)> default_handler;
 
+    struct RealtimeSlot
+    {
+      std::atomic<MenuBase *> target{nullptr};
+      std::atomic<bool> popup{false};  // A bind_popup() for the same input wins
+      std::atomic<uint8_t> running{0}; // Handlers in flight, so unbind() can wait them out
+    };
+
+    std::array<RealtimeSlot, MAX_REALTIME_INDEX> realtime_gate;
+    std::array<RealtimeSlot, MAX_REALTIME_INDEX> realtime_toggle;
+    std::atomic<uint32_t> rt_count{0};
+    std::atomic<uint32_t> rt_last_us{0};
+    std::atomic<uint32_t> rt_worst_us{0};
+
+    RealtimeSlot *realtime_slot(MenuEvent::Source src, uint8_t idx);
+
     bool handle_hardwired_interceptors(const MenuEvent &ev);
     bool handle_temporary_interceptors(const MenuEvent &ev);
     void set_default_handler(std::function<void(MenuEvent)> handler)
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <esp32_ui/menu_event.h>
+#include <esp32_ui/display.h>
+
+/**
+ * @file event_trace.h
+ * @brief Record the MenuEvents entering UIManager::dispatch_event and replay them.
+ *
+ * Trace format (little endian, no padding):
+ *   header:  'E' 'U' 'T' <version>
+ *   records: <delta_us as LEB128 varint> <source> <type> <index>
+ *
+ * delta_us is the time since the previous record (since start() for the first one),
+ * so a typical record is 4-6 bytes.
+ *
+ * HOW TO USE:
+ * - Record on the device:  UIManager::set_trace_recorder(&rec); rec.start();
+ * - Dump rec.data()/rec.size() somewhere (serial, SD card, ...).
+ * - Replay against the same menu tree with EventReplayer::replay(), either at the
+ *   original pace or as fast as possible, then compare framebuffer_checksum() or your
+ *   field values against the expected result.
+ */
+
+namespace esp32_ui
+{
+  class EventTraceRecorder
+  {
+  public:
+    inline static constexpr uint8_t VERSION = 1;
+    inline static constexpr size_t HEADER_SIZE = 4;
+    inline static constexpr size_t MAX_RECORD_SIZE = 8;
+
+    EventTraceRecorder(size_t capacity_bytes = 4096);
+
+    void start();
+    void stop() { recording = false; }
+    bool is_recording() const { return recording; }
+    void clear();
+
+    // Appends one record. Once the buffer is full, further events are counted
+    // as dropped rather than recorded, so the trace is always a clean prefix.
+    void record(const MenuEvent &ev, uint32_t now_us);
+
+    const uint8_t *data() const { return buf.data(); }
+    size_t size() const { return buf.size(); }
+    size_t dropped() const { return n_dropped; }
+
+  private:
+    std::vector<uint8_t> buf;
+    size_t capacity;
+    uint32_t last_us = 0;
+    size_t n_dropped = 0;
+    bool recording = false;
+    std::mutex buf_mutex;
+  };
+
+  class EventTraceReader
+  {
+  public:
+    EventTraceReader(const uint8_t *trace, size_t len);
+
+    // False if the header is missing or from a different version
+    bool valid() const { return ok; }
+
+    // Reads the next record; false at the end of the trace (or on a truncated record)
+    bool next(MenuEvent &ev, uint32_t &delta_us);
+
+  private:
+    const uint8_t *p;
+    const uint8_t *end;
+    bool ok;
+  };
+
+  class EventReplayer
+  {
+  public:
+    enum class Pace
+    {
+      Original,
+      AsFastAsPossible
+    };
+
+    // Feeds every event in the trace through EventRouter::dispatch, servicing sync
+    // requests after each one the way the dispatch task does when its queue drains.
+    // Returns the number of events replayed.
+    static size_t replay(const uint8_t *trace, size_t len, Pace pace = Pace::AsFastAsPossible);
+
+    // Draws the current top menu into the buffer and hashes it (FNV-1a). Nothing is
+    // sent to the panel; with a page buffer each page is drawn and hashed in turn.
+    // Shares the buffer with the display task, so don't run both at once.
+    static uint32_t framebuffer_checksum(Display *d);
+  };
+
+} // namespace esp32_ui
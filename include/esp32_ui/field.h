@@ -15,6 +15,12 @@
 #include <esp32_ui/element.h>
 #include <esp32_ui/widget.h>
 #include <esp32_ui/event_router.h>
+#include <esp32_ui/commit_batch.h>
+#include <esp32_ui/value_cell.h>
+#include <esp32_ui/accel_curve.h>
+#include <esp32_ui/budget.h>
+#include <esp32_ui/field_numeric.h>
+#include <esp32_ui/edit_journal.h>
 
 namespace esp32_ui
 {
@@ -22,6 +28,15 @@ namespace esp32_ui
   {
   protected:
     const char *delimiter;
+    uint16_t field_id = 0;
+    Accelerator accel;
+
+    // True if an open CommitTransaction took the commit; otherwise call the setter.
+    // delta: value is a change rather than the new value (see CommitBatch::Record).
+    bool defer_commit(int64_t value, bool delta = false) const
+    {
+      return CommitBatch::instance()->record(field_id, field_data_type(), value, delta);
+    }
 
   public:
     FieldBase(const char *label,
@@ -36,26 +51,51 @@ namespace esp32_ui
     virtual BaseType base_type() const override final { return BaseType::Field; }
     virtual FieldDataType field_data_type() const override = 0;
 
+    // Identifies the field in CommitBatch records; 0 (the default) opts out
+    virtual void set_field_id(uint16_t id) { field_id = id; }
+    uint16_t get_field_id() const { return field_id; }
+
     virtual void commit() = 0; // Confirm edit
     virtual void cancel() = 0; // Revert edit
 
+    // Sets the committed value from its raw form (NumericCore::to_raw) and delivers it
+    // like a commit; used by undo/redo and presets. Returns false if unsupported.
+    virtual bool restore_raw(int64_t raw) { return false; }
+    // The committed value in the same form; false if unsupported
+    virtual bool committed_raw(int64_t &raw) { return false; }
+    // Bytes the raw form needs (0 if unsupported) and its fraction bits (Fixed only)
+    virtual uint8_t raw_size() const { return 0; }
+    virtual uint8_t raw_frac_bits() const { return 0; }
+
     virtual void handle_draw(Display *d) const override;
     virtual void print_delimiter(Display *d) const { d->print(delimiter); }
     virtual void print_value(Display *d) const override = 0;
     virtual bool handle_nav_delta(const MenuEvent &ev);
-    virtual void apply_delta(int8_t delta) = 0;
+    virtual void apply_delta(delta_t delta) = 0;
+
+    // Speeds up NavLeft/NavRight (and NavUp/NavDown big steps) while the encoder
+    // turns quickly; see accel_curve.h. max_multiplier = 1 turns it off.
+    void set_acceleration(uint16_t slow_ms, uint16_t fast_ms, uint16_t max_multiplier)
+    {
+      accel.set_curve(AccelCurve{slow_ms, fast_ms, max_multiplier});
+    }
+    void set_acceleration(const AccelCurve &curve) { accel.set_curve(curve); }
   };
 
   template <typename T>
   class ValueField : public FieldBase
   {
+    static_assert(NumericCore<T>::supported, "ValueField<T>: T must be an integer, float or Fixed<>");
+    using Core = NumericCore<T>;
+
   protected:
     std::function<void(const T &from, const T &to)> on_change_cb;
-    T big_step = 0;
+    T big_step{};
 
   public:
-    T perma_val;
-    T temp_val;
+    // Written by the dispatch task, read from anywhere (display task, audio task)
+    ValueCell<T> perma_val;
+    ValueCell<T> temp_val;
     T min;
     T max;
     T step;
@@ -83,78 +123,49 @@ namespace esp32_ui
       menuprintf("%s: ValueField handle_nav_delta\n", label);
       if (ev.type == MenuEvent::Type::NavLeft)
       {
-        apply_delta(-step);
+        apply_delta(accel.scale(-Core::to_delta(step), ev));
         return true;
       }
 
       if (ev.type == MenuEvent::Type::NavRight)
       {
-        apply_delta(step);
+        apply_delta(accel.scale(Core::to_delta(step), ev));
         return true;
       }
 
-      if (!big_step)
+      if (big_step == T{})
       {
         return false;
       }
 
       if (ev.type == MenuEvent::Type::NavUp)
       {
-        apply_delta(-big_step);
+        apply_delta(accel.scale(-Core::to_delta(big_step), ev));
         return true;
       }
 
       if (ev.type == MenuEvent::Type::NavDown)
       {
-        apply_delta(big_step);
+        apply_delta(accel.scale(Core::to_delta(big_step), ev));
         return true;
       }
 
       return false;
     }
 
-    virtual void apply_delta(int8_t delta) override
+    virtual void apply_delta(delta_t delta) override
     {
       menuprintf("%s: ValueField apply_delta(%d)\n", this->label, delta);
-      if (delta > 0)
-      {
-        if (temp_val + delta <= max)
-        {
-          temp_val += delta;
-        }
-        else if (wrappable && (delta == 1))
-        {
-          temp_val = min;
-        }
-        else
-        {
-          temp_val = max;
-        }
-      }
-      else if (delta < 0)
-      {
-        if (temp_val + delta >= min)
-        {
-          temp_val += delta;
-        }
-        else if (wrappable && (delta == -1))
-        {
-          temp_val = max;
-        }
-        else
-        {
-          temp_val = min;
-        }
-      }
-      else
+      if (!delta)
       {
         return;
       }
+      temp_val = Core::step(temp_val.load(), delta, min, max, wrappable);
       FieldBase::apply_delta(0);
     }
 
-    virtual T value() const { return temp_val; }
-    virtual void print_value(Display *d) const override { d->print(temp_val); }
+    virtual T value() const { return temp_val.load(); }
+    virtual void print_value(Display *d) const override { Core::print(d, temp_val.load()); }
     void set_big_step(T val) { big_step = val; }
 
     std::function<T()> getter_cb;
@@ -165,12 +176,13 @@ namespace esp32_ui
       menuprintf("%s value sync\n", this->label);
       if (this->getter_cb)
       {
+        UI_BUDGET(Getter, this->label);
         T val = this->getter_cb();
         menuprint("gotten: ");
         this->perma_val = val;
         menuprintln(val);
       }
-      this->temp_val = this->perma_val;
+      this->temp_val = this->perma_val.load();
       menuprintln("==============");
     }
 
@@ -185,35 +197,66 @@ namespace esp32_ui
     {
       assert(cb);
       setter_cb = std::move(cb);
-      this->setter_cb(this->perma_val);
+      UI_BUDGET(Setter, this->label);
+      this->setter_cb(this->perma_val.load());
     }
 
     // Apply the edit to the model
     virtual void commit() override
     {
-      perma_val = temp_val;
-      if (setter_cb)
+      const T val = temp_val.load();
+      const T old = perma_val.load();
+      if (val != old)
       {
-        setter_cb(perma_val);
+        EditJournal::instance()->record(this, Core::to_raw(old), Core::to_raw(val));
       }
+      deliver(val);
+    }
+
+    virtual bool restore_raw(int64_t raw) override
+    {
+      // A preset may come from a build with a wider range
+      const T val = Core::clamp(Core::from_raw(raw), min, max);
+      temp_val = val;
+      deliver(val);
+      return true;
     }
 
+    virtual bool committed_raw(int64_t &raw) override
+    {
+      raw = Core::to_raw(perma_val.load());
+      return true;
+    }
+    virtual uint8_t raw_size() const override { return Core::raw_size; }
+    virtual uint8_t raw_frac_bits() const override { return Core::frac_bits; }
+
     // Revert local state to original
     virtual void cancel() override
     {
-      temp_val = perma_val;
+      temp_val = perma_val.load();
     }
 
-    virtual FieldDataType field_data_type() const override { return FieldDataType::None; }
-  };
+    virtual FieldDataType field_data_type() const override { return Core::type; }
 
-  template <>
-  inline FieldBase::FieldDataType ValueField<int8_t>::field_data_type() const { return FieldDataType::Int8; }
-  template <>
-  inline FieldBase::FieldDataType ValueField<uint8_t>::field_data_type() const { return FieldDataType::UInt8; }
-  template <>
-  inline FieldBase::FieldDataType ValueField<int16_t>::field_data_type() const { return FieldDataType::Int16; }
-  template <>
-  inline FieldBase::FieldDataType ValueField<uint16_t>::field_data_type() const { return FieldDataType::UInt16; }
+  protected:
+    void deliver(T val)
+    {
+      if (val != perma_val.load())
+      {
+        // Other menu levels may show something derived from this
+        MenuStack::bump_sync_generation();
+      }
+      perma_val = val;
+      if (defer_commit(Core::to_raw(val)))
+      {
+        return;
+      }
+      if (setter_cb)
+      {
+        UI_BUDGET(Setter, this->label);
+        setter_cb(val);
+      }
+    }
+  };
 
 } // namespace esp32_ui
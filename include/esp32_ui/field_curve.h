@@ -0,0 +1,318 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <array>
+#include <functional>
+
+#include <esp32_ui/field.h>
+
+/**
+ * @file field_curve.h
+ * @brief Table-driven non-linear parameter mapping.
+ *
+ * Frequency, time and gain parameters want exponential or logarithmic travel. Rather
+ * than doing that math in every getter and setter, a MappedField edits a plain index
+ * 0..N-1 and looks the engineering value (and optionally its display string) up in a
+ * table built at compile time:
+ *
+ *   static constexpr auto CUTOFF = make_exp_curve<uint16_t, 128>(20, 20000);
+ *   ...
+ *   auto f = std::make_unique<MappedField<uint16_t>>("Cutoff", FieldCurve<uint16_t>(CUTOFF, "Hz"), 1000);
+ *   f->register_value_getter([] { return filter.cutoff(); });
+ *   f->register_value_setter([](uint16_t hz) { filter.set_cutoff(hz); });
+ *
+ * The curve functions run in constant evaluation only, so no pow()/log() is left on
+ * the edit, commit or draw paths, and a table declared static constexpr is placed in
+ * .rodata (flash on the ESP32). Tables must be non-decreasing: MappedField snaps its
+ * initial value and every getter result to an index with a binary search, and asserts
+ * ascending() on construction. Check a table at compile time with
+ *
+ *   static_assert(FieldCurve<uint16_t>(CUTOFF).ascending());
+ *
+ * FieldCurve only points at the table, so the table must outlive it; building one
+ * from a temporary does not compile.
+ */
+
+namespace esp32_ui
+{
+  // Constant-evaluation helpers for building tables
+  namespace curve_math
+  {
+    inline constexpr double LN2 = 0.69314718055994530942;
+    inline constexpr double LN10 = 2.30258509299404568402;
+
+    constexpr double exp(double x)
+    {
+      // x = n * ln2 + r, |r| <= ln2 / 2
+      const long n = long((x >= 0) ? (x / LN2 + 0.5) : (x / LN2 - 0.5));
+      const double r = x - n * LN2;
+
+      double term = 1.0;
+      double sum = 1.0;
+      for (int i = 1; i < 24; ++i)
+      {
+        term *= r / i;
+        sum += term;
+      }
+
+      for (long i = 0; i < n; ++i)
+      {
+        sum *= 2.0;
+      }
+      for (long i = 0; i > n; --i)
+      {
+        sum *= 0.5;
+      }
+      return sum;
+    }
+
+    // x > 0
+    constexpr double log(double x)
+    {
+      // x = m * 2^k with m in [0.5, 1)
+      long k = 0;
+      while (x >= 1.0)
+      {
+        x *= 0.5;
+        ++k;
+      }
+      while (x < 0.5)
+      {
+        x *= 2.0;
+        --k;
+      }
+
+      // ln(m) = 2 * atanh((m - 1) / (m + 1))
+      const double y = (x - 1.0) / (x + 1.0);
+      const double y2 = y * y;
+      double term = y;
+      double sum = 0.0;
+      for (int i = 1; i < 60; i += 2)
+      {
+        sum += term / i;
+        term *= y2;
+      }
+      return 2.0 * sum + k * LN2;
+    }
+
+    template <typename V>
+    constexpr V to_value(double x)
+    {
+      if constexpr (std::is_integral_v<V>)
+      {
+        return V((x < 0) ? (x - 0.5) : (x + 0.5));
+      }
+      else if constexpr (is_fixed<V>::value)
+      {
+        return V::from_double(x);
+      }
+      else
+      {
+        return V(x);
+      }
+    }
+
+    template <typename V>
+    constexpr double to_double(V v)
+    {
+      if constexpr (is_fixed<V>::value)
+      {
+        return double(v.raw) / V::ONE;
+      }
+      else
+      {
+        return double(v);
+      }
+    }
+  } // namespace curve_math
+
+  template <typename V, size_t N>
+  using CurveTable = std::array<V, N>;
+
+  // f maps t in [0, 1] to the value; must be usable in a constant expression
+  template <typename V, size_t N, typename F>
+  constexpr CurveTable<V, N> make_curve(F f)
+  {
+    static_assert(N >= 2, "A curve needs at least two points");
+    CurveTable<V, N> table{};
+    for (size_t i = 0; i < N; ++i)
+    {
+      table[i] = curve_math::to_value<V>(f(double(i) / (N - 1)));
+    }
+    return table;
+  }
+
+  template <typename V, size_t N>
+  constexpr CurveTable<V, N> make_linear_curve(double lo, double hi)
+  {
+    return make_curve<V, N>([lo, hi](double t)
+                            { return lo + (hi - lo) * t; });
+  }
+
+  // Equal ratios per step (frequency, time); lo and hi must be > 0
+  template <typename V, size_t N>
+  constexpr CurveTable<V, N> make_exp_curve(double lo, double hi)
+  {
+    return make_curve<V, N>([lo, hi](double t)
+                            { return lo * curve_math::exp(t * curve_math::log(hi / lo)); });
+  }
+
+  // Coarse at the bottom, fine at the top
+  template <typename V, size_t N>
+  constexpr CurveTable<V, N> make_log_curve(double lo, double hi)
+  {
+    return make_curve<V, N>([lo, hi](double t)
+                            { return lo + (hi - lo) * curve_math::log(1.0 + 9.0 * t) / curve_math::LN10; });
+  }
+
+  // Linear gain steps in dB, stored as amplitude ratios (scale = 1.0 for unity)
+  template <typename V, size_t N>
+  constexpr CurveTable<V, N> make_db_curve(double db_lo, double db_hi, double scale = 1.0)
+  {
+    return make_curve<V, N>([db_lo, db_hi, scale](double t)
+                            { return scale * curve_math::exp((db_lo + (db_hi - db_lo) * t) * curve_math::LN10 / 20.0); });
+  }
+
+  // Non-owning view of a curve table, its optional labels, and a unit suffix
+  template <typename V>
+  struct FieldCurve
+  {
+    const V *values = nullptr;
+    const char *const *labels = nullptr; // one per entry, or nullptr to print values
+    uint16_t size = 0;
+    const char *unit = nullptr;
+
+    constexpr FieldCurve() = default;
+
+    template <size_t N>
+    constexpr FieldCurve(const CurveTable<V, N> &table, const char *unit = nullptr)
+        : values(table.data()),
+          size(uint16_t(N)),
+          unit(unit)
+    {
+      static_assert(N <= UINT16_MAX, "Curve too long");
+    }
+
+    template <size_t N>
+    constexpr FieldCurve(const CurveTable<V, N> &table, const char *const (&labels)[N])
+        : values(table.data()),
+          labels(labels),
+          size(uint16_t(N))
+    {
+      static_assert(N <= UINT16_MAX, "Curve too long");
+    }
+
+    // The view would dangle
+    template <size_t N>
+    FieldCurve(const CurveTable<V, N> &&table, const char *unit = nullptr) = delete;
+    template <size_t N>
+    FieldCurve(const CurveTable<V, N> &&table, const char *const (&labels)[N]) = delete;
+
+    constexpr uint16_t last() const { return size ? size - 1 : 0; }
+    constexpr V at(uint16_t i) const { return values[(i < size) ? i : last()]; }
+
+    // True if every entry is >= the one before it, as index_of() requires
+    constexpr bool ascending() const
+    {
+      for (uint16_t i = 1; i < size; ++i)
+      {
+        if (values[i] < values[i - 1])
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    // Index of the entry closest to v (binary search; values must be non-decreasing)
+    constexpr uint16_t index_of(V v) const
+    {
+      if (!size)
+      {
+        return 0;
+      }
+
+      uint16_t lo = 0;
+      uint16_t hi = last();
+      while (lo < hi)
+      {
+        const uint16_t mid = lo + (hi - lo) / 2;
+        if (values[mid] < v)
+        {
+          lo = mid + 1;
+        }
+        else
+        {
+          hi = mid;
+        }
+      }
+
+      // values[lo] is the first entry >= v; the one before it may be closer
+      if (lo && (curve_math::to_double(v) - curve_math::to_double(values[lo - 1]) < curve_math::to_double(values[lo]) - curve_math::to_double(v)))
+      {
+        return lo - 1;
+      }
+      return lo;
+    }
+
+    void print(Display *d, uint16_t i) const
+    {
+      if (labels)
+      {
+        d->print(labels[(i < size) ? i : last()]);
+        return;
+      }
+      NumericCore<V>::print(d, at(i));
+      if (unit)
+      {
+        d->print(unit);
+      }
+    }
+  };
+
+  // Edits an index into a FieldCurve; getters and setters see the mapped value
+  template <typename V>
+  class MappedField : public ValueField<uint16_t>
+  {
+  protected:
+    FieldCurve<V> curve;
+
+  public:
+    MappedField(const char *label,
+                const FieldCurve<V> &curve,
+                V initial,
+                const char *delimiter = ": ")
+        : ValueField<uint16_t>(label, curve.index_of(initial), 0, curve.last(), 1, delimiter),
+          curve(curve)
+    {
+      assert(curve.ascending());
+    }
+
+    virtual ~MappedField() = default;
+
+    const FieldCurve<V> &get_curve() const { return curve; }
+
+    // The value being shown/edited, and the last committed one
+    V mapped_value() const { return curve.at(temp_val.load()); }
+    V committed_value() const { return curve.at(perma_val.load()); }
+
+    virtual void print_value(Display *d) const override { curve.print(d, temp_val.load()); }
+
+    // Model values are snapped to the nearest table entry
+    void register_value_getter(std::function<V()> cb)
+    {
+      assert(cb);
+      register_getter([this, cb = std::move(cb)]()
+                      { return curve.index_of(cb()); });
+    }
+
+    void register_value_setter(std::function<void(V)> cb)
+    {
+      assert(cb);
+      register_setter([this, cb = std::move(cb)](uint16_t i)
+                      { cb(curve.at(i)); });
+    }
+  };
+
+} // namespace esp32_ui
@@ -0,0 +1,288 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <limits>
+#include <type_traits>
+
+#include <esp32_ui/element.h>
+
+/**
+ * @file field_numeric.h
+ * @brief Overflow-safe arithmetic for every field value type.
+ *
+ * NumericCore<T> is specialized at compile time for each supported value type and
+ * gives ValueField (and friends) one set of primitives:
+ *
+ *   add_sat(v, d, lo, hi)   v + d, clamped to [lo, hi], never overflowing T
+ *   add_wrap(v, d, lo, hi)  v + d, wrapped around inside [lo, hi]
+ *   step(v, d, lo, hi, w)   what an edit does: single steps past either end wrap if
+ *                           w (wrappable) is set, everything else saturates
+ *   to_delta(step)          a step value expressed in delta_t units
+ *   lowest() / highest()    the type's full range, for fields without limits
+ *   difference(a, b)        a - b as a T (wrapping for integers)
+ *   to_raw / from_raw       lossless int64_t round trip (commit batches, presets)
+ *   raw_size, frac_bits     bytes the raw form needs, and its binary scale (presets)
+ *   print(d, v)
+ *
+ * Supported types: all integers up to 64 bits, float, and Fixed<Frac, Rep> binary
+ * fixed point. Deltas are delta_t (int32_t) in the type's smallest unit: 1 for
+ * integers, one LSB (raw) for Fixed, and 1/DELTA_SCALE for float.
+ */
+
+namespace esp32_ui
+{
+  // Binary fixed point: value = raw / 2^Frac
+  template <uint8_t Frac, typename Rep = int32_t>
+  struct Fixed
+  {
+    static_assert(std::is_integral_v<Rep> && std::is_signed_v<Rep>, "Fixed<> needs a signed integer Rep");
+    static_assert(Frac < sizeof(Rep) * 8 - 1, "Too many fraction bits for Rep");
+
+    using rep = Rep;
+    inline static constexpr uint8_t frac_bits = Frac;
+    inline static constexpr Rep ONE = Rep(1) << Frac;
+
+    Rep raw = 0;
+
+    static constexpr Fixed from_raw(Rep r)
+    {
+      Fixed f;
+      f.raw = r;
+      return f;
+    }
+
+    static constexpr Fixed from_double(double v)
+    {
+      return from_raw(static_cast<Rep>(v * ONE + ((v < 0) ? -0.5 : 0.5)));
+    }
+
+    constexpr float to_float() const { return float(raw) / ONE; }
+
+    constexpr bool operator==(const Fixed &o) const { return raw == o.raw; }
+    constexpr bool operator!=(const Fixed &o) const { return raw != o.raw; }
+    constexpr bool operator<(const Fixed &o) const { return raw < o.raw; }
+    constexpr bool operator<=(const Fixed &o) const { return raw <= o.raw; }
+    constexpr bool operator>(const Fixed &o) const { return raw > o.raw; }
+    constexpr bool operator>=(const Fixed &o) const { return raw >= o.raw; }
+  };
+
+  template <typename T>
+  struct is_fixed : std::false_type
+  {
+  };
+
+  template <uint8_t Frac, typename Rep>
+  struct is_fixed<Fixed<Frac, Rep>> : std::true_type
+  {
+  };
+
+  template <typename T, typename = void>
+  struct NumericCore
+  {
+    inline static constexpr bool supported = false;
+    inline static constexpr Element::FieldDataType type = Element::FieldDataType::None;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Integers
+  template <typename T>
+  struct NumericCore<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && (sizeof(T) <= 8)>>
+  {
+    inline static constexpr bool supported = true;
+
+    static constexpr Element::FieldDataType data_type()
+    {
+      if constexpr (sizeof(T) == 1)
+      {
+        return std::is_signed_v<T> ? Element::FieldDataType::Int8 : Element::FieldDataType::UInt8;
+      }
+      else if constexpr (sizeof(T) == 2)
+      {
+        return std::is_signed_v<T> ? Element::FieldDataType::Int16 : Element::FieldDataType::UInt16;
+      }
+      else if constexpr (sizeof(T) == 4)
+      {
+        return std::is_signed_v<T> ? Element::FieldDataType::Int32 : Element::FieldDataType::UInt32;
+      }
+      else
+      {
+        // No UInt64 in FieldDataType; raw values round-trip through int64_t anyway
+        return Element::FieldDataType::Int64;
+      }
+    }
+    inline static constexpr Element::FieldDataType type = data_type();
+    inline static constexpr uint8_t raw_size = sizeof(T);
+    inline static constexpr uint8_t frac_bits = 0;
+
+    static constexpr T clamp(T v, T lo, T hi) { return (v < lo) ? lo : ((v > hi) ? hi : v); }
+
+    static constexpr T lowest() { return std::numeric_limits<T>::lowest(); }
+    static constexpr T highest() { return std::numeric_limits<T>::max(); }
+    static constexpr T difference(T a, T b) { return T(uint64_t(a) - uint64_t(b)); }
+
+    static constexpr T add_sat(T v, delta_t d, T lo, T hi)
+    {
+      T r = 0;
+      if (__builtin_add_overflow(v, d, &r))
+      {
+        return (d > 0) ? hi : lo;
+      }
+      return clamp(r, lo, hi);
+    }
+
+    static constexpr T add_wrap(T v, delta_t d, T lo, T hi)
+    {
+      // Work on offsets from lo, mod 2^64; span == 0 stands for the full 2^64 range
+      const uint64_t span = uint64_t(hi) - uint64_t(lo) + 1;
+      const uint64_t off = uint64_t(clamp(v, lo, hi)) - uint64_t(lo);
+      uint64_t mag = (d >= 0) ? uint64_t(d) : uint64_t(-int64_t(d));
+      if (!span)
+      {
+        return T(uint64_t(lo) + ((d >= 0) ? off + mag : off - mag));
+      }
+
+      mag %= span;
+      return T(uint64_t(lo) + ((d >= 0) ? (off + mag) : (off + span - mag)) % span);
+    }
+
+    static constexpr T step(T v, delta_t d, T lo, T hi, bool wrappable)
+    {
+      if (wrappable && ((d == 1) || (d == -1)))
+      {
+        return add_wrap(v, d, lo, hi);
+      }
+      return add_sat(v, d, lo, hi);
+    }
+
+    // Steps wider than delta_t saturate
+    static constexpr delta_t to_delta(T step)
+    {
+      if constexpr (std::is_signed_v<T>)
+      {
+        return delta_t(clamp_to_delta(step));
+      }
+      else
+      {
+        return (uint64_t(step) > uint64_t(std::numeric_limits<delta_t>::max())) ? std::numeric_limits<delta_t>::max() : delta_t(step);
+      }
+    }
+
+    static constexpr int64_t to_raw(T v) { return int64_t(v); }
+    static constexpr T from_raw(int64_t raw) { return T(raw); }
+
+    template <typename Out>
+    static void print(Out *d, T v) { d->print(v); }
+
+  private:
+    static constexpr int64_t clamp_to_delta(T v)
+    {
+      const int64_t w = int64_t(v);
+      // Symmetric, so negating a step can't overflow
+      const int64_t lo = -int64_t(std::numeric_limits<delta_t>::max());
+      const int64_t hi = std::numeric_limits<delta_t>::max();
+      return (w < lo) ? lo : ((w > hi) ? hi : w);
+    }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Fixed point: deltas are in raw units (one LSB)
+  template <typename T>
+  struct NumericCore<T, std::enable_if_t<is_fixed<T>::value>>
+  {
+    using Rep = typename T::rep;
+    using RawCore = NumericCore<Rep>;
+
+    inline static constexpr bool supported = true;
+    inline static constexpr Element::FieldDataType type = Element::FieldDataType::Fixed;
+    inline static constexpr uint8_t raw_size = sizeof(Rep);
+    inline static constexpr uint8_t frac_bits = T::frac_bits;
+
+    static constexpr T clamp(T v, T lo, T hi) { return T::from_raw(RawCore::clamp(v.raw, lo.raw, hi.raw)); }
+    static constexpr T lowest() { return T::from_raw(RawCore::lowest()); }
+    static constexpr T highest() { return T::from_raw(RawCore::highest()); }
+    static constexpr T difference(T a, T b) { return T::from_raw(RawCore::difference(a.raw, b.raw)); }
+
+    static constexpr T add_sat(T v, delta_t d, T lo, T hi) { return T::from_raw(RawCore::add_sat(v.raw, d, lo.raw, hi.raw)); }
+    static constexpr T add_wrap(T v, delta_t d, T lo, T hi) { return T::from_raw(RawCore::add_wrap(v.raw, d, lo.raw, hi.raw)); }
+    static constexpr T step(T v, delta_t d, T lo, T hi, bool wrappable) { return T::from_raw(RawCore::step(v.raw, d, lo.raw, hi.raw, wrappable)); }
+    static constexpr delta_t to_delta(T step) { return RawCore::to_delta(step.raw); }
+
+    static constexpr int64_t to_raw(T v) { return int64_t(v.raw); }
+    static constexpr T from_raw(int64_t raw) { return T::from_raw(Rep(raw)); }
+
+    template <typename Out>
+    static void print(Out *d, T v) { d->print(double(v.to_float()), (T::frac_bits > 6) ? 3 : 2); }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  // float: deltas are in 1/DELTA_SCALE units
+  template <>
+  struct NumericCore<float>
+  {
+    inline static constexpr bool supported = true;
+    inline static constexpr Element::FieldDataType type = Element::FieldDataType::Float;
+    inline static constexpr uint8_t raw_size = sizeof(float);
+    inline static constexpr uint8_t frac_bits = 0;
+    inline static constexpr float DELTA_SCALE = 1000.0f;
+
+    static constexpr float clamp(float v, float lo, float hi) { return (v < lo) ? lo : ((v > hi) ? hi : v); }
+    static constexpr float lowest() { return std::numeric_limits<float>::lowest(); }
+    static constexpr float highest() { return std::numeric_limits<float>::max(); }
+    static constexpr float difference(float a, float b) { return a - b; }
+    static constexpr float add_sat(float v, delta_t d, float lo, float hi) { return clamp(v + d / DELTA_SCALE, lo, hi); }
+
+    static constexpr float add_wrap(float v, delta_t d, float lo, float hi)
+    {
+      const float r = v + d / DELTA_SCALE;
+      if (r > hi)
+      {
+        return lo;
+      }
+      if (r < lo)
+      {
+        return hi;
+      }
+      return r;
+    }
+
+    static constexpr float step(float v, delta_t d, float lo, float hi, bool wrappable)
+    {
+      const float r = v + d / DELTA_SCALE;
+      if (wrappable && ((r > hi) || (r < lo)))
+      {
+        // Same rule as the integers: only a step that starts at the end wraps
+        return (v == ((d > 0) ? hi : lo)) ? ((d > 0) ? lo : hi) : clamp(r, lo, hi);
+      }
+      return clamp(r, lo, hi);
+    }
+
+    static constexpr delta_t to_delta(float step)
+    {
+      const float d = step * DELTA_SCALE;
+      return (d >= 2147483520.0f) ? std::numeric_limits<delta_t>::max() : ((d <= -2147483520.0f) ? -std::numeric_limits<delta_t>::max() : delta_t(d + ((d < 0) ? -0.5f : 0.5f)));
+    }
+
+    static int64_t to_raw(float v)
+    {
+      uint32_t bits;
+      memcpy(&bits, &v, sizeof(bits));
+      return int64_t(bits);
+    }
+
+    static float from_raw(int64_t raw)
+    {
+      const uint32_t bits = uint32_t(raw);
+      float v;
+      memcpy(&v, &bits, sizeof(v));
+      return v;
+    }
+
+    template <typename Out>
+    static void print(Out *d, float v) { d->print(double(v), 2); }
+  };
+
+  template <typename T>
+  constexpr Element::FieldDataType field_data_type_of() { return NumericCore<T>::type; }
+
+} // namespace esp32_ui
@@ -0,0 +1,370 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include <esp32_ui/field.h>
+
+/**
+ * @file field_store.h
+ * @brief Contiguous, per-type storage for large numbers of fields.
+ *
+ * A ValueField keeps its state inside its own heap node, so syncing or committing a
+ * page of several hundred parameters means walking the whole Canvas/Widget tree.
+ * A FieldStore keeps the same state (perma, temp, min, max, step, big_step) in one
+ * array per member and per value type, and the UI nodes (StoredField<T>) only hold an
+ * index into it. Page-wide operations (sync_all(), cancel_all(), commit_all(),
+ * snapshot(), restore()) become linear scans over those arrays.
+ *
+ * Columns exist for int8_t through uint32_t and float; other NumericCore types
+ * (int64_t, Fixed<>) use ValueField.
+ *
+ * The store must outlive every StoredField made from it. Like the rest of the tree,
+ * it is only meant to be touched from the UI tasks.
+ */
+
+namespace esp32_ui
+{
+  // One array per field member, all indexed by the same slot number
+  template <typename T>
+  struct FieldColumns
+  {
+    std::vector<T> perma;
+    std::vector<T> temp;
+    std::vector<T> min;
+    std::vector<T> max;
+    std::vector<T> step;
+    std::vector<T> big_step;
+    std::vector<std::function<T()>> getter;
+    std::vector<std::function<void(T)>> setter;
+    std::vector<uint16_t> id; // CommitBatch field ids, 0 = not batched
+    std::vector<const char *> label; // The StoredField's label, for budgets
+
+    uint16_t size() const { return perma.size(); }
+
+    void reserve(size_t n)
+    {
+      perma.reserve(n);
+      temp.reserve(n);
+      min.reserve(n);
+      max.reserve(n);
+      step.reserve(n);
+      big_step.reserve(n);
+      getter.reserve(n);
+      setter.reserve(n);
+      id.reserve(n);
+      label.reserve(n);
+    }
+
+    uint16_t add(const char *name, T initial, T lo, T hi, T st, T big = 0)
+    {
+      perma.push_back(initial);
+      temp.push_back(initial);
+      min.push_back(lo);
+      max.push_back(hi);
+      step.push_back(st);
+      big_step.push_back(big);
+      getter.emplace_back();
+      setter.emplace_back();
+      id.push_back(0);
+      label.push_back(name);
+      return size() - 1;
+    }
+
+    // Hands the committed value to the open CommitTransaction, or to the setter
+    void deliver(uint16_t i)
+    {
+      if (CommitBatch::instance()->record(id[i], field_data_type_of<T>(), NumericCore<T>::to_raw(perma[i])))
+      {
+        return;
+      }
+      if (setter[i])
+      {
+        UI_BUDGET(Setter, label[i]);
+        setter[i](perma[i]);
+      }
+    }
+
+    void sync(uint16_t i)
+    {
+      if (getter[i])
+      {
+        UI_BUDGET(Getter, label[i]);
+        perma[i] = getter[i]();
+      }
+      temp[i] = perma[i];
+    }
+
+    void commit(uint16_t i)
+    {
+      if (temp[i] != perma[i])
+      {
+        MenuStack::bump_sync_generation();
+      }
+      perma[i] = temp[i];
+      deliver(i);
+    }
+
+    void cancel(uint16_t i) { temp[i] = perma[i]; }
+
+    void sync_all()
+    {
+      for (size_t i = 0; i < getter.size(); ++i)
+      {
+        if (getter[i])
+        {
+          UI_BUDGET(Getter, label[i]);
+          perma[i] = getter[i]();
+        }
+      }
+      std::copy(perma.begin(), perma.end(), temp.begin());
+    }
+
+    void cancel_all() { std::copy(perma.begin(), perma.end(), temp.begin()); }
+
+    // Only slots with a pending edit reach their setter
+    void commit_all()
+    {
+      for (size_t i = 0; i < perma.size(); ++i)
+      {
+        if (temp[i] != perma[i])
+        {
+          MenuStack::bump_sync_generation();
+          perma[i] = temp[i];
+          deliver(i);
+        }
+      }
+    }
+
+    // Returns false if the snapshot was taken with a different number of slots; the
+    // overlapping slots are restored anyway
+    bool restore(const std::vector<T> &values)
+    {
+      const size_t n = std::min(values.size(), perma.size());
+      for (size_t i = 0; i < n; ++i)
+      {
+        const bool changed = (values[i] != perma[i]);
+        perma[i] = values[i];
+        temp[i] = values[i];
+        if (changed)
+        {
+          MenuStack::bump_sync_generation();
+          deliver(i);
+        }
+      }
+      return values.size() == perma.size();
+    }
+  };
+
+  // A field whose state lives in a FieldStore
+  template <typename T>
+  class StoredField : public FieldBase
+  {
+  protected:
+    FieldColumns<T> &cols;
+    const uint16_t idx;
+
+  public:
+    StoredField(const char *label,
+                FieldColumns<T> &cols,
+                uint16_t idx,
+                const char *delimiter = ": ")
+        : FieldBase(label, delimiter),
+          cols(cols),
+          idx(idx)
+    {
+      wrappable = false;
+    }
+
+    virtual ~StoredField() = default;
+
+    uint16_t index() const { return idx; }
+
+    virtual void set_field_id(uint16_t id) override
+    {
+      FieldBase::set_field_id(id);
+      cols.id[idx] = id;
+    }
+
+    virtual T value() const { return cols.temp[idx]; }
+    void set_big_step(T val) { cols.big_step[idx] = val; }
+
+    virtual bool handle_nav_delta(const MenuEvent &ev) override
+    {
+      menuprintf("%s: StoredField handle_nav_delta\n", label);
+      const T step = cols.step[idx];
+      const T big_step = cols.big_step[idx];
+      if (ev.type == MenuEvent::Type::NavLeft)
+      {
+        apply_delta(accel.scale(-NumericCore<T>::to_delta(step), ev));
+        return true;
+      }
+
+      if (ev.type == MenuEvent::Type::NavRight)
+      {
+        apply_delta(accel.scale(NumericCore<T>::to_delta(step), ev));
+        return true;
+      }
+
+      if (big_step == T{})
+      {
+        return false;
+      }
+
+      if (ev.type == MenuEvent::Type::NavUp)
+      {
+        apply_delta(accel.scale(-NumericCore<T>::to_delta(big_step), ev));
+        return true;
+      }
+
+      if (ev.type == MenuEvent::Type::NavDown)
+      {
+        apply_delta(accel.scale(NumericCore<T>::to_delta(big_step), ev));
+        return true;
+      }
+
+      return false;
+    }
+
+    virtual void apply_delta(delta_t delta) override
+    {
+      menuprintf("%s: StoredField apply_delta(%d)\n", this->label, delta);
+      if (!delta)
+      {
+        return;
+      }
+      cols.temp[idx] = NumericCore<T>::step(cols.temp[idx], delta, cols.min[idx], cols.max[idx], wrappable);
+      FieldBase::apply_delta(0);
+    }
+
+    virtual void print_value(Display *d) const override { NumericCore<T>::print(d, value()); }
+
+    virtual void handle_sync() override { cols.sync(idx); }
+    virtual void commit() override
+    {
+      const T old = cols.perma[idx];
+      cols.commit(idx);
+      if (cols.perma[idx] != old)
+      {
+        EditJournal::instance()->record(this, NumericCore<T>::to_raw(old), NumericCore<T>::to_raw(cols.perma[idx]));
+      }
+    }
+
+    virtual bool restore_raw(int64_t raw) override
+    {
+      cols.temp[idx] = NumericCore<T>::clamp(NumericCore<T>::from_raw(raw), cols.min[idx], cols.max[idx]);
+      cols.commit(idx);
+      return true;
+    }
+
+    virtual bool committed_raw(int64_t &raw) override
+    {
+      raw = NumericCore<T>::to_raw(cols.perma[idx]);
+      return true;
+    }
+    virtual uint8_t raw_size() const override { return NumericCore<T>::raw_size; }
+    virtual uint8_t raw_frac_bits() const override { return NumericCore<T>::frac_bits; }
+    virtual void cancel() override { cols.cancel(idx); }
+
+    virtual void register_getter(std::function<T()> cb)
+    {
+      assert(cb);
+      cols.getter[idx] = std::move(cb);
+      handle_sync();
+    }
+
+    virtual void register_setter(std::function<void(T)> cb)
+    {
+      assert(cb);
+      cols.setter[idx] = std::move(cb);
+      UI_BUDGET(Setter, label);
+      cols.setter[idx](cols.perma[idx]);
+    }
+
+    virtual FieldDataType field_data_type() const override { return field_data_type_of<T>(); }
+  };
+
+  class FieldStore
+  {
+    template <typename T>
+    using Values = std::vector<T>;
+
+    template <template <typename> class C>
+    using PerType = std::tuple<C<int8_t>, C<uint8_t>, C<int16_t>, C<uint16_t>, C<int32_t>, C<uint32_t>, C<float>>;
+
+    PerType<FieldColumns> columns;
+
+    template <typename F>
+    void for_each_column(F &&f)
+    {
+      std::apply([&](auto &...c)
+                 { (f(c), ...); },
+                 columns);
+    }
+
+  public:
+    // Saved perma values of every slot, per type
+    using Snapshot = PerType<Values>;
+
+    template <typename T>
+    FieldColumns<T> &column() { return std::get<FieldColumns<T>>(columns); }
+
+    template <typename T>
+    const FieldColumns<T> &column() const { return std::get<FieldColumns<T>>(columns); }
+
+    template <typename T>
+    void reserve(size_t n) { column<T>().reserve(n); }
+
+    // Adds a slot and returns the UI node bound to it
+    template <typename T>
+    std::unique_ptr<StoredField<T>> make_field(const char *label,
+                                               T initial,
+                                               T min, T max, T step,
+                                               const char *delimiter = ": ")
+    {
+      const uint16_t idx = column<T>().add(label, initial, min, max, step);
+      return std::make_unique<StoredField<T>>(label, column<T>(), idx, delimiter);
+    }
+
+    void sync_all()
+    {
+      for_each_column([](auto &c)
+                      { c.sync_all(); });
+    }
+
+    void cancel_all()
+    {
+      for_each_column([](auto &c)
+                      { c.cancel_all(); });
+    }
+
+    void commit_all()
+    {
+      for_each_column([](auto &c)
+                      { c.commit_all(); });
+    }
+
+    Snapshot snapshot() const
+    {
+      Snapshot snap;
+      std::apply([this](auto &...v)
+                 { ((v = column<typename std::decay_t<decltype(v)>::value_type>().perma), ...); },
+                 snap);
+      return snap;
+    }
+
+    // Writes the snapshot back (perma and temp), calling setters for slots that
+    // changed. Returns false if the store's layout no longer matches the snapshot.
+    bool restore(const Snapshot &snap)
+    {
+      bool ok = true;
+      std::apply([this, &ok](const auto &...v)
+                 { ((ok &= column<typename std::decay_t<decltype(v)>::value_type>().restore(v)), ...); },
+                 snap);
+      return ok;
+    }
+  };
+
+} // namespace esp32_ui
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <esp32_ui/display.h>
+
+/**
+ * @file font_metrics.h
+ * @brief Cached glyph advances for measuring, truncating and aligning text.
+ *
+ * The first time a font is seen, FontMetrics asks the display for the advance of
+ * every printable ASCII glyph (32..126) and keeps the table, keyed by the font
+ * pointer. After that, measuring a string is one table lookup per character, so
+ * layout code can fit, ellipsize and align text in O(length) without rasterizing
+ * anything. The widths match what print() does: the sum of the glyph advances.
+ *
+ * Bytes outside 32..126 (UTF-8 sequences, control characters) are counted as the
+ * font's widest glyph, which errs on the side of truncating early.
+ *
+ * Only the display task draws, so like the layout caches this isn't locked.
+ */
+
+namespace esp32_ui
+{
+  class FontMetrics
+  {
+  public:
+    inline static constexpr uint8_t FIRST_GLYPH = 32;
+    inline static constexpr uint8_t LAST_GLYPH = 126;
+    inline static constexpr size_t NUM_GLYPHS = LAST_GLYPH - FIRST_GLYPH + 1;
+    inline static constexpr size_t MAX_FONTS = 4;
+    // Used before any font has been set
+    inline static constexpr uint8_t FALLBACK_ADVANCE = 8;
+
+    inline static constexpr const char *ELLIPSIS = "...";
+
+    enum class Align : uint8_t
+    {
+      Left,
+      Center,
+      Right
+    };
+
+    // Meyers singleton
+    static FontMetrics *instance();
+
+    uint8_t advance(Display *d, char c);
+    uint8_t max_advance(Display *d);
+
+    // Width of the first max_len characters of s
+    uint16_t text_width(Display *d, const char *s, size_t max_len = SIZE_MAX);
+
+    // How many leading characters of s fit in max_w pixels
+    size_t fit(Display *d, const char *s, uint16_t max_w);
+
+    // Copy as much of s as fits in max_w into out (always terminated); returns the
+    // number of characters copied
+    size_t truncate(Display *d, const char *s, uint16_t max_w, char *out, size_t out_size);
+
+    // Like truncate(), but if s doesn't fit, end with ELLIPSIS
+    size_t ellipsize(Display *d, const char *s, uint16_t max_w, char *out, size_t out_size);
+
+    // x at which to print s so it's aligned within [x, x + w)
+    uint16_t align_x(Display *d, const char *s, uint16_t x, uint16_t w, Align align);
+
+    // Drops every cached table (e.g. after swapping font data at the same address)
+    void clear();
+
+  private:
+    FontMetrics() = default;
+
+    struct GlyphTable
+    {
+      const uint8_t *font = nullptr;
+      uint8_t advance[NUM_GLYPHS];
+      uint8_t widest;
+    };
+
+    const GlyphTable &table(Display *d);
+    void build(GlyphTable &t, Display *d);
+    static uint8_t lookup(const GlyphTable &t, char c);
+
+    GlyphTable tables[MAX_FONTS];
+    GlyphTable fallback;
+    uint8_t last_used = 0;
+    uint8_t next_slot = 0;
+  };
+
+} // namespace esp32_ui
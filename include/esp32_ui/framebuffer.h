@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <esp32_ui/display.h>
+
+/**
+ * @file framebuffer.h
+ * @brief Word-at-a-time raster operations on the U8g2 tile buffer.
+ *
+ * U8g2 full-buffer drivers store the screen as tile rows: one byte per pixel column
+ * per 8-pixel-high row, least significant bit on top. A horizontal band inside one
+ * tile row is therefore the same bit mask in every byte, so it can be set, cleared or
+ * inverted four columns at a time by replicating the mask across a 32-bit word.
+ * Inverting a full 128x8 highlight bar is 32 word operations.
+ *
+ * Rectangles are in panel coordinates. With a page-buffer driver (ESP32_UI_PAGE_BUFFER)
+ * the buffer holds only the page being drawn, and rectangles are clipped to it;
+ * xor_overlay() and scrolling work on whatever the buffer holds, so they're only
+ * meaningful with a full buffer.
+ *
+ * A FrameBuffer is a cheap view; construct one on the stack whenever you need it.
+ */
+
+namespace esp32_ui
+{
+  class FrameBuffer
+  {
+  public:
+    enum class RasterOp
+    {
+      Set,
+      Clear,
+      Xor
+    };
+
+    explicit FrameBuffer(Display *d)
+        : buf(d->getBufferPtr()),
+          stride(d->getBufferTileWidth() * 8),
+          tile_rows(d->getBufferTileHeight()),
+          top(d->buffer_top())
+    {
+    }
+
+    uint16_t width() const { return stride; }
+    uint16_t height() const { return uint16_t(tile_rows) * 8; }
+    size_t size() const { return size_t(stride) * tile_rows; }
+
+    // Rectangles are clipped to the buffer
+    void fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h) { apply(RasterOp::Set, x, y, w, h); }
+    void clear_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h) { apply(RasterOp::Clear, x, y, w, h); }
+    void invert_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h) { apply(RasterOp::Xor, x, y, w, h); }
+
+    // Full-width highlight bar
+    void invert_rows(uint16_t y, uint16_t h) { apply(RasterOp::Xor, 0, y, stride, h); }
+
+    // XOR a bitmap stored in the same tile layout (and size) over the buffer
+    void xor_overlay(const uint8_t *src);
+
+    // Move the whole picture by whole tile rows (8 pixels), blanking what's uncovered
+    void scroll_up(uint8_t rows);
+    void scroll_down(uint8_t rows);
+
+    void apply(RasterOp op, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+  private:
+    uint8_t *buf;
+    uint16_t stride; // Bytes per tile row == width in pixels
+    uint8_t tile_rows;
+    uint16_t top; // Panel row of the buffer's first pixel row
+  };
+
+} // namespace esp32_ui
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * @file layout.h
+ * @brief Cached draw positions for Canvas rows and Widget columns.
+ *
+ * Row rectangles, label widths and value column positions only change when the tree
+ * changes or the font/panel does, so nodes compute them once in update_layout() and
+ * handle_draw() just prints at the cached coordinates.
+ *
+ * Each node keeps a LayoutStamp. A stamp goes stale when the node itself changes
+ * (add_element(), set_cursor_offset(), ...) or when the global layout generation
+ * moves on. Call Layout::invalidate_all() after changing the font, rotation or any
+ * other display setting that affects text metrics; the display task does so once
+ * after start_display().
+ */
+
+namespace esp32_ui
+{
+  class Layout
+  {
+    // Starts at 1, so a fresh stamp (0) is always stale
+    inline static std::atomic<uint32_t> gen{1};
+
+  public:
+    static void invalidate_all()
+    {
+      uint32_t next = gen.load(std::memory_order_relaxed) + 1;
+      gen.store(next ? next : 1, std::memory_order_release);
+    }
+    static uint32_t generation() { return gen.load(std::memory_order_acquire); }
+  };
+
+  class LayoutStamp
+  {
+    std::atomic<uint32_t> gen{0};
+
+  public:
+    bool is_stale() const { return gen.load(std::memory_order_acquire) != Layout::generation(); }
+
+    // Call before recomputing, so an invalidate() that lands mid-pass isn't lost
+    void mark_current() { gen.store(Layout::generation(), std::memory_order_release); }
+    void invalidate() { gen.store(0, std::memory_order_release); }
+  };
+
+  struct RowRect
+  {
+    uint8_t y; // baseline passed to setCursor()
+    uint8_t h;
+  };
+
+} // namespace esp32_ui
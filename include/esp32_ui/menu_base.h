@@ -3,6 +3,8 @@
 #include <functional>
 #include <esp32_ui/menu_event.h>
 #include <esp32_ui/display.h>
+#include <esp32_ui/display_registry.h>
+#include <esp32_ui/budget.h>
 
 namespace esp32_ui
 {
@@ -15,6 +17,10 @@ namespace esp32_ui
     Element
   };
 
+  // Signed amount a value moves by in one apply_delta(); wide enough for an
+  // accelerated step across a 14-bit range
+  using delta_t = int32_t;
+
   class MenuBase
   {
   public:
@@ -36,17 +42,19 @@ namespace esp32_ui
     bool is_wrappable() const { return wrappable; }
     virtual bool event_filter(const MenuEvent &ev) const { return false; }
 
+    // Every panel showing the menu redraws; the display task owns their buffers
     void go_schleep()
     {
-      Display::instance()->clearBuffer();
       schleeping = true;
       dirty_screen = true;
+      DisplayRegistry::instance()->mark_menus_dirty();
     }
 
     void wake_up()
     {
       schleeping = false;
       dirty_screen = true;
+      DisplayRegistry::instance()->mark_menus_dirty();
     }
 
     bool is_schleep()
@@ -120,13 +128,18 @@ namespace esp32_ui
       handle_sync();
       if (on_enter_cb)
       {
+        UI_BUDGET(Enter, label);
         on_enter_cb();
       }
     }
+    // Coming back to a menu whose data is still current (see MenuStack); by default
+    // the same as entering it
+    virtual void handle_resume() { handle_enter(); }
     virtual void handle_exit()
     {
       if (on_exit_cb)
       {
+        UI_BUDGET(Exit, label);
         on_exit_cb();
       }
     }
@@ -150,7 +163,7 @@ namespace esp32_ui
     virtual void commit() {}
     virtual void cancel() {}
 
-    virtual void apply_delta(int8_t delta) { menuprintf("%s:MenuBase  apply_delta [%d]\n", label, delta); }
+    virtual void apply_delta(delta_t delta) { menuprintf("%s:MenuBase  apply_delta [%d]\n", label, delta); }
 
     virtual void print_event(const MenuEvent &ev) const
     {
@@ -50,6 +50,10 @@ namespace esp32_ui
 
     uint8_t index = 0;
 
+    // millis() when the event was dispatched (0 = unknown). Not part of the event's
+    // identity: ignored by operator== and operator<.
+    uint32_t timestamp_ms = 0;
+
     MenuEvent(Source src = System,
               Type t = NoType,
               uint8_t idx = 0)
@@ -78,6 +82,7 @@ namespace esp32_ui
     }
 
     int8_t MAIN_ENCODER_INDEX = 0;
+    bool INVERT_HIGHLIGHT = false;
 
   public:
     static UIState *instance()
@@ -93,6 +98,14 @@ namespace esp32_ui
       MAIN_ENCODER_INDEX = idx;
     }
     int8_t main_encoder_idx() { return MAIN_ENCODER_INDEX; }
+
+    // Highlight the selected row by inverting it in the frame buffer instead of
+    // drawing '>' / '[' ']' markers around it
+    void set_invert_highlight(bool on_off)
+    {
+      INVERT_HIGHLIGHT = on_off;
+    }
+    bool invert_highlight() const { return INVERT_HIGHLIGHT; }
   };
 
   inline const char *event_source_to_str(MenuEvent::Source src)
@@ -136,6 +149,14 @@ namespace esp32_ui
       return "ButtonReleased";
     case MenuEvent::Type::Draw:
       return "Draw";
+    case MenuEvent::Type::ModeSwitch:
+      return "ModeSwitch";
+    case MenuEvent::Type::FreezeData:
+      return "FreezeData";
+    case MenuEvent::Type::UnfreezeData:
+      return "UnfreezeData";
+    case MenuEvent::Type::Sync:
+      return "Sync";
     default:
       return "UnknownEvent";
     }
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include <esp32_ui/canvas.h>
+
+/**
+ * @file menu_index.h
+ * @brief Sorted label table over the whole menu tree, for search and jump-to.
+ *
+ * build() walks the tree once, starting at the root Canvas, and records every Canvas
+ * (reached through a Widget's submenu) and every Widget row together with the path
+ * of widget indices that leads to it. Entries are sorted by label (ASCII case
+ * insensitive), so a prefix search is a binary search plus a scan over the matches:
+ *
+ *   MenuIndex index;
+ *   index.build(root);
+ *   auto hits = index.find_prefix("cut");
+ *   if (hits.begin != hits.end)
+ *   {
+ *     index.jump(*hits.begin); // one push/enter, no matter how deep
+ *   }
+ *
+ * Labels aren't copied, only pointed to, and paths share one byte array, so an entry
+ * costs 8 bytes plus its path length. Rebuild after adding or removing nodes, or after
+ * changing EventRouter::set_max_menu_depth(); nodes deeper than that are left out.
+ */
+
+namespace esp32_ui
+{
+  class MenuIndex
+  {
+  public:
+    enum class Kind : uint8_t
+    {
+      Canvas, // jump opens it
+      Widget  // jump selects its row
+    };
+
+    struct Entry
+    {
+      const char *label;
+      uint16_t path_offset;
+      uint8_t path_len;
+      Kind kind;
+    };
+
+    struct Range
+    {
+      const Entry *begin;
+      const Entry *end;
+      size_t size() const { return end - begin; }
+    };
+
+    // Indexes everything reachable from root; returns the number of entries
+    size_t build(Canvas *root);
+    void clear();
+
+    size_t size() const { return entries.size(); }
+    const Entry &at(size_t i) const { return entries[i]; }
+
+    // Entries whose label starts with prefix (case insensitive), in label order
+    Range find_prefix(const char *prefix) const;
+    // First entry with exactly this label, or nullptr
+    const Entry *find(const char *label) const;
+
+    const uint8_t *path(const Entry &e) const { return paths.data() + e.path_offset; }
+
+    // Hands the entry's path to EventRouter::jump_to(); must run on the dispatch task
+    bool jump(const Entry &e) const;
+
+  private:
+    void walk(Canvas *canvas, uint8_t *path, uint8_t depth);
+    void add(const char *label, const uint8_t *path, uint8_t len, Kind kind);
+
+    std::vector<Entry> entries;
+    std::vector<uint8_t> paths;
+    size_t max_depth = 0;
+  };
+
+} // namespace esp32_ui
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include <esp32_ui/canvas.h>
+#include <esp32_ui/field.h>
+
+/**
+ * @file preset.h
+ * @brief Save and recall every field value as one compact binary blob.
+ *
+ * build() walks the menu tree once and collects every field that has a field id
+ * (see FieldBase::set_field_id()); fields that live outside the tree, such as a
+ * FieldStore's, can be added with add(). save() writes their committed values,
+ * keyed by id, and load() puts them back:
+ *
+ *   Preset preset;
+ *   preset.build(root);
+ *
+ *   std::vector<uint8_t> blob;
+ *   preset.save(blob);              // store it in NVS, SPIFFS, ...
+ *   preset.load(blob.data(), blob.size());
+ *
+ * load() compares each stored value with the field's current one and only restores
+ * the fields that differ. Those go through the usual setter path inside a single
+ * CommitTransaction, so a batch handler gets the whole preset in one call. Recall
+ * isn't recorded in the EditJournal, and it ends with one redraw instead of a
+ * request_sync().
+ *
+ * load() changes field state and runs setters, so like EditJournal::undo() it must
+ * run on the event dispatch task: call it from a Bang or other element handler,
+ * never straight from an input ISR or another task.
+ *
+ * Blob layout, little endian:
+ *
+ *   header: 'E' 'U' 'I' 'P', version (u8), reserved (u8), count (u16)
+ *   entry:  field id (u16), FieldDataType (u8), size (u8), fraction bits (u8),
+ *           value (size bytes)
+ *
+ * Values are the field's raw int64_t form (NumericCore::to_raw), trimmed to the
+ * width of its type. Entries with an unknown id, or whose type, width or fraction bits
+ * no longer match the field, are skipped, so a preset survives fields being added,
+ * removed or retyped (including a Fixed<8> that became a Fixed<12>).
+ * Rebuild after adding or removing fields.
+ */
+
+namespace esp32_ui
+{
+  class Preset
+  {
+  public:
+    inline static constexpr uint8_t MAGIC[4] = {'E', 'U', 'I', 'P'};
+    inline static constexpr uint8_t VERSION = 2;
+    inline static constexpr size_t HEADER_SIZE = 8;
+    inline static constexpr size_t ENTRY_HEADER_SIZE = 5;
+
+    // Collects every field with an id reachable from root; returns how many
+    size_t build(Canvas *root);
+    // For fields outside the tree; returns false without an id or for a duplicate
+    bool add(FieldBase *field);
+    void clear() { fields.clear(); }
+
+    size_t size() const { return fields.size(); }
+
+    // Replaces out with the current committed values; returns its size
+    size_t save(std::vector<uint8_t> &out) const;
+
+    // Restores the fields whose value differs from the blob. Returns false if the
+    // blob isn't a preset (bad magic, newer version or truncated); nothing is
+    // restored then. changed, if given, receives the number of fields restored.
+    bool load(const uint8_t *data, size_t len, size_t *changed = nullptr);
+
+    // Number of fields load() would restore, without touching anything
+    size_t diff(const uint8_t *data, size_t len) const;
+
+  private:
+    struct Item
+    {
+      FieldBase *field;
+      int64_t raw;
+    };
+
+    void walk(Element *node);
+    FieldBase *find(uint16_t id) const;
+
+    // Decodes the blob and calls fn(field, raw) for each entry that differs from
+    // its field; false if the blob is invalid
+    template <typename Fn>
+    bool for_each_change(const uint8_t *data, size_t len, Fn fn) const;
+
+    std::vector<FieldBase *> fields; // sorted by id
+  };
+
+} // namespace esp32_ui
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp32_ui
+{
+  // Wait-free single-producer/single-consumer ring of decimated min/max columns.
+  //
+  // The producer (audio or control task) calls push() once per sample. Samples are
+  // folded into a running min/max pair and every `samples_per_column` samples that
+  // pair is published as one column. push() never blocks, never allocates and never
+  // waits for the consumer; if the consumer falls behind, the oldest columns are
+  // simply overwritten.
+  //
+  // The consumer (display task) calls snapshot() to copy out the newest columns.
+  // Columns the producer overwrote while they were being copied are detected and
+  // dropped, so the consumer never sees a torn min/max pair.
+  template <typename T, size_t N>
+  class MinMaxRing
+  {
+    static_assert((N & (N - 1)) == 0, "MinMaxRing size must be a power of two");
+
+  public:
+    struct Column
+    {
+      T lo;
+      T hi;
+    };
+
+    static constexpr size_t capacity() { return N; }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Producer side
+    void push(T sample)
+    {
+      if (pending == 0)
+      {
+        acc.lo = sample;
+        acc.hi = sample;
+      }
+      else if (sample < acc.lo)
+      {
+        acc.lo = sample;
+      }
+      else if (sample > acc.hi)
+      {
+        acc.hi = sample;
+      }
+
+      if (++pending < samples_per_column.load(std::memory_order_relaxed))
+      {
+        return;
+      }
+
+      const uint32_t h = head.load(std::memory_order_relaxed);
+      columns[h & (N - 1)] = acc;
+      head.store(h + 1, std::memory_order_release);
+      pending = 0;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Consumer side
+    //
+    // Copies up to `count` of the newest columns into `out`, oldest first, and
+    // returns how many were copied.
+    size_t snapshot(Column *out, size_t count) const
+    {
+      const uint32_t h = head.load(std::memory_order_acquire);
+      size_t n = (count < N) ? count : N;
+      if (n > h)
+      {
+        n = h;
+      }
+
+      const uint32_t first = h - n;
+      for (size_t i = 0; i < n; ++i)
+      {
+        out[i] = columns[(first + i) & (N - 1)];
+      }
+
+      // Anything older than (h2 - N + 1) may have been rewritten while we copied it
+      std::atomic_thread_fence(std::memory_order_acquire);
+      const uint32_t h2 = head.load(std::memory_order_relaxed);
+      const uint32_t oldest_valid = (h2 >= N) ? (h2 - N + 1) : 0;
+      if (first >= oldest_valid)
+      {
+        return n;
+      }
+
+      const size_t torn = oldest_valid - first;
+      if (torn >= n)
+      {
+        return 0;
+      }
+
+      for (size_t i = torn; i < n; ++i)
+      {
+        out[i - torn] = out[i];
+      }
+      return n - torn;
+    }
+
+    // How many input samples make up one published column. Safe to call from the
+    // consumer while the producer is running; takes effect on the next column.
+    void set_samples_per_column(uint16_t n)
+    {
+      samples_per_column.store(n ? n : 1, std::memory_order_relaxed);
+    }
+
+    uint16_t get_samples_per_column() const
+    {
+      return samples_per_column.load(std::memory_order_relaxed);
+    }
+
+    // Total number of columns ever published
+    uint32_t published() const { return head.load(std::memory_order_acquire); }
+
+  private:
+    Column columns[N] = {};
+    std::atomic<uint32_t> head{0};
+    std::atomic<uint16_t> samples_per_column{1};
+
+    // Producer-private accumulator
+    Column acc = {};
+    uint16_t pending = 0;
+  };
+
+} // namespace esp32_ui
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <esp32_ui/widget.h>
+#include <esp32_ui/sample_ring.h>
+
+// Live signal plot. A producer task writes samples with write(); the display task
+// plots the newest columns across the screen width, one min/max vertical line per
+// pixel column. Drawing costs O(screen width) no matter how many samples were
+// written since the last frame.
+//
+// The plot is `height` pixels tall starting at the row the parent Canvas puts it
+// on, so give it a Canvas of its own (or put it last) if it's taller than a row.
+
+namespace esp32_ui
+{
+  class ScopeWidget : public Widget
+  {
+  public:
+    // Must be a power of two, and at least twice the widest panel so the producer
+    // can run a full screen ahead of the display task without tearing columns
+    inline static constexpr size_t RING_SIZE = 256;
+    inline static constexpr size_t MAX_COLUMNS = RING_SIZE / 2;
+
+    using Ring = MinMaxRing<int16_t, RING_SIZE>;
+
+  protected:
+    Ring ring;
+    int16_t range_lo;
+    int16_t range_hi;
+    uint8_t height;
+
+    // Scratch for the display task; keeps 512 bytes off the task stack. In page-buffer
+    // mode it's filled on the plot's first page and reused for the rest of the frame.
+    mutable Ring::Column scratch[MAX_COLUMNS];
+    mutable size_t scratch_len = 0;
+
+  public:
+    ScopeWidget(const char *label,
+                int16_t range_lo,
+                int16_t range_hi,
+                uint8_t height = 24,
+                uint16_t samples_per_column = 1)
+        : Widget(label),
+          range_lo(range_lo),
+          range_hi(range_hi),
+          height(height)
+    {
+      ring.set_samples_per_column(samples_per_column);
+    }
+
+    virtual ~ScopeWidget() = default;
+
+    virtual const char *widget_type() const override { return "ScopeWidget"; }
+
+    // Producer side; wait-free, safe to call from the audio/control task
+    void write(int16_t sample) { ring.push(sample); }
+
+    void set_range(int16_t lo, int16_t hi)
+    {
+      range_lo = lo;
+      range_hi = hi;
+    }
+
+    void set_height(uint8_t h) { height = h; }
+    virtual uint8_t draw_height() const override { return height; }
+    void set_samples_per_column(uint16_t n) { ring.set_samples_per_column(n); }
+
+    virtual void handle_draw(Display *d) const override;
+  };
+
+} // namespace esp32_ui
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <stdint.h>
+#include <esp32_ui/display.h>
+
+/**
+ * @file screen_saver.h
+ * @brief Budgeted screen-saver effects.
+ *
+ * While the root menu is asleep, UIManager::display_task hands the frame buffer to a
+ * ScreenSaverEngine (if any effects were added to it). Each effect declares how many
+ * microseconds it may spend per frame. The engine times every frame and, when an
+ * effect runs over, first lowers the effect's resolution, then skips frames, and
+ * finally goes dormant: the screen is blanked once and no more frames are rendered
+ * until the UI wakes up.
+ */
+
+namespace esp32_ui
+{
+  class ScreenSaverEffect
+  {
+  public:
+    virtual ~ScreenSaverEffect() = default;
+
+    // CPU time (in microseconds) the effect may spend rendering one frame
+    virtual uint32_t budget_us() const = 0;
+
+    // How many times the engine may halve the effect's resolution
+    virtual uint8_t max_coarseness() const { return 0; }
+
+    // Called when the screen saver (re)starts
+    virtual void reset() {}
+
+    // Render one frame into the (already cleared) display buffer.
+    // coarseness == 0 is full resolution; each step up halves it.
+    virtual void render(Display *d, uint32_t frame, uint8_t coarseness) = 0;
+  };
+
+  // 3D starfield in 8.8 fixed point
+  class Starfield : public ScreenSaverEffect
+  {
+  public:
+    inline static constexpr uint8_t NUM_STARS = 48;
+
+    Starfield(uint32_t budget_us = 1500, uint8_t speed = 3)
+        : budget(budget_us),
+          speed(speed)
+    {
+    }
+
+    virtual uint32_t budget_us() const override { return budget; }
+    virtual uint8_t max_coarseness() const override { return 3; }
+    virtual void reset() override;
+    virtual void render(Display *d, uint32_t frame, uint8_t coarseness) override;
+
+  protected:
+    struct Star
+    {
+      int8_t x;
+      int8_t y;
+      uint16_t z; // 8.8 fixed point depth
+    };
+
+    Star stars[NUM_STARS];
+    uint32_t budget;
+    uint8_t speed;
+    uint32_t seed = 0x1234567;
+
+    void respawn(Star &s);
+  };
+
+  // Ordered-dither plasma from a 64-entry sine table. Coarser levels dither whole
+  // blocks and fill them as rectangles
+  class Plasma : public ScreenSaverEffect
+  {
+  public:
+    Plasma(uint32_t budget_us = 4000)
+        : budget(budget_us)
+    {
+    }
+
+    virtual uint32_t budget_us() const override { return budget; }
+    virtual uint8_t max_coarseness() const override { return 3; }
+    virtual void render(Display *d, uint32_t frame, uint8_t coarseness) override;
+
+  protected:
+    uint32_t budget;
+  };
+
+  // Single line of text crawling right to left, vertically centered
+  class ScrollingText : public ScreenSaverEffect
+  {
+  public:
+    ScrollingText(const char *text, uint32_t budget_us = 1000, uint8_t px_per_frame = 1)
+        : text(text),
+          budget(budget_us),
+          px_per_frame(px_per_frame)
+    {
+    }
+
+    virtual uint32_t budget_us() const override { return budget; }
+    virtual void reset() override { x = INT16_MAX; }
+    virtual void render(Display *d, uint32_t frame, uint8_t coarseness) override;
+
+  protected:
+    const char *text;
+    uint32_t budget;
+    uint8_t px_per_frame;
+    int16_t x = INT16_MAX;
+    int16_t text_width = -1;
+  };
+
+  class ScreenSaverEngine
+  {
+  public:
+    // Frames are skipped in powers of two up to this, then the engine goes dormant
+    inline static constexpr uint8_t MAX_FRAME_SKIP = 7;
+    // Consecutive over-budget frames before degrading one step
+    inline static constexpr uint8_t OVERRUN_STREAK = 2;
+    // Consecutive frames under half the budget before recovering one step
+    inline static constexpr uint8_t RECOVER_STREAK = 30;
+
+    ScreenSaverEngine() = default;
+
+    void add_effect(std::unique_ptr<ScreenSaverEffect> effect);
+    bool has_effects() const { return !effects.empty(); }
+    void next_effect();
+
+    // Called by the display task once per frame while the root is asleep.
+    // Returns true if a new frame was put in the buffer and should be sent.
+    bool tick(Display *d);
+
+    // Called by the display task while the UI is awake
+    void stop() { running = false; }
+
+    // Force (or leave) the near-zero-CPU mode: one blank frame, then nothing
+    void set_dormant(bool on_off);
+    bool is_dormant() const { return dormant; }
+
+    uint8_t get_coarseness() const { return coarseness; }
+    uint8_t get_frame_skip() const { return frame_skip; }
+    uint32_t last_frame_us() const { return last_cost_us; }
+
+  protected:
+    std::vector<std::unique_ptr<ScreenSaverEffect>> effects;
+    size_t current = 0;
+
+    bool running = false;
+    bool dormant = false;
+    bool forced_dormant = false;
+    bool dormant_frame_sent = false;
+
+    uint32_t frame = 0;
+    uint32_t last_cost_us = 0;
+    uint8_t coarseness = 0;
+    uint8_t frame_skip = 0;
+    uint8_t skip_count = 0;
+    uint8_t over_streak = 0;
+    uint8_t under_streak = 0;
+
+    void start();
+    void degrade(const ScreenSaverEffect &effect);
+    void recover();
+  };
+
+} // namespace esp32_ui
@@ -13,19 +13,51 @@ namespace esp32_ui
     Delta
   };
 
+  // Steps, encodes and prints through NumericCore<T> like ValueField. One detent moves
+  // it by step (one whole unit unless set: 1, 1.0f, Fixed 1.0). It has no limits of
+  // its own: Absolute edits saturate at the type's range, Delta edits wrap around it,
+  // since only the difference reaches the setter.
   template <typename T>
   class SockPuppet : public FieldBase
   {
+    using Core = NumericCore<T>;
+    static_assert(Core::supported, "SockPuppet needs a numeric T (see field_numeric.h)");
+
   protected:
     std::function<T()> getter_cb;
     std::function<void(T)> setter_cb;
     latchable<T> state;
+    ValueCell<T> shown; // state.in(), published for readers on other tasks
+
+    void publish() { shown = state.in(); }
+
+    static constexpr T one()
+    {
+      if constexpr (is_fixed<T>::value)
+      {
+        return T::from_raw(T::ONE);
+      }
+      else
+      {
+        return T(1);
+      }
+    }
+
+    // Detents to delta units, saturating
+    delta_t scale(delta_t detents) const
+    {
+      const int64_t d = int64_t(detents) * Core::to_delta(step);
+      const int64_t lim = std::numeric_limits<delta_t>::max();
+      return delta_t((d > lim) ? lim : ((d < -lim) ? -lim : d));
+    }
 
   public:
     EditMode mode;
 
     const char *delimiter;
 
+    T step = one();
+
     SockPuppet(const char *label,
                EditMode mode = EditMode::Absolute,
                const char *delimiter = ": ")
@@ -37,32 +69,42 @@ namespace esp32_ui
 
     virtual ~SockPuppet() = default;
 
-    virtual void apply_delta(int8_t delta) override
+    virtual void apply_delta(delta_t delta) override
     {
       menuprintf("%s: SockPuppet apply_delta %d\n", this->label, delta);
-      auto tmp = state.in() + (T)delta;
-      state.set_input(tmp);
+      const delta_t d = scale(delta);
+      if (mode == EditMode::Delta)
+      {
+        state.set_input(Core::add_wrap(state.in(), d, Core::lowest(), Core::highest()));
+      }
+      else
+      {
+        state.set_input(Core::add_sat(state.in(), d, Core::lowest(), Core::highest()));
+      }
+      publish();
     }
 
     virtual T value() const
     {
-      return state.in();
+      return shown.load();
     }
 
     virtual void print_value(Display *d) const override
     {
-      d->print(value());
+      Core::print(d, value());
     }
 
     virtual void handle_sync() override
     {
       if (this->getter_cb)
       {
+        UI_BUDGET(Getter, this->label);
         T val = this->getter_cb();
         if (val != state.out()) // Only update if changed, avoiding unnecessary redraws/focus loss
         {
-          menuprintf("sync %s: %d --> %d\n", this->label, state.out, val);
+          menuprintf("sync %s: %lld --> %lld\n", this->label, (long long)Core::to_raw(state.out()), (long long)Core::to_raw(val));
           state.clock_in(val);
+          publish();
         }
       }
       menuprintln("==============");
@@ -79,6 +121,7 @@ namespace esp32_ui
     {
       assert(cb);
       setter_cb = std::move(cb);
+      UI_BUDGET(Setter, this->label);
       setter_cb(state.out());
     }
 
@@ -86,25 +129,55 @@ namespace esp32_ui
     virtual void commit() override
     {
       menuprintf("%s: commit\n", this->label);
-      T delta = state.in() - state.out();
+      const T delta = Core::difference(state.in(), state.out());
+      if (state.in() != state.out())
+      {
+        MenuStack::bump_sync_generation();
+        EditJournal::instance()->record(this, Core::to_raw(state.out()), Core::to_raw(state.in()));
+      }
       state.clock();
+      if (this->defer_commit(Core::to_raw((mode == EditMode::Delta) ? delta : state.out()), mode == EditMode::Delta))
+      {
+        return;
+      }
       if (this->setter_cb)
       {
         if (mode == EditMode::Delta)
         {
           // setter_cb moves the index in array of possible values
-          menuprintf("%s: SockPuppet setter_cb (delta=%d)\n", this->label, delta);
+          menuprintf("%s: SockPuppet setter_cb (delta=%lld)\n", this->label, (long long)Core::to_raw(delta));
+          UI_BUDGET(Setter, this->label);
           this->setter_cb(delta);
         }
         else
         {
           // setter_cb sets the value directly
           menuprintf("%s: SockPuppet setter_cb\n", this->label);
+          UI_BUDGET(Setter, this->label);
           this->setter_cb(state.out());
         }
       }
     }
 
+    // Goes through commit(), so Delta mode setters get the difference as usual
+    virtual bool restore_raw(int64_t raw) override
+    {
+      // Same range apply_delta() keeps to; also catches a stored float infinity
+      state.set_input(Core::clamp(Core::from_raw(raw), Core::lowest(), Core::highest()));
+      publish();
+      EditJournal::Pause pause;
+      commit();
+      return true;
+    }
+
+    virtual bool committed_raw(int64_t &raw) override
+    {
+      raw = Core::to_raw(state.out());
+      return true;
+    }
+    virtual uint8_t raw_size() const override { return Core::raw_size; }
+    virtual uint8_t raw_frac_bits() const override { return Core::frac_bits; }
+
     virtual void cancel() override
     {
       // I haven't fully decided whether to permit cancels. It probably
@@ -115,9 +188,10 @@ namespace esp32_ui
       assert(false && "SockPuppet does not support cancel()");
 
       state.loopback();
+      publish();
       menuprintf("%s: cancel\n", this->label);
     }
 
-    virtual FieldDataType field_data_type() const override { return FieldDataType::None; }
+    virtual FieldDataType field_data_type() const override { return field_data_type_of<T>(); }
   };
 }
@@ -0,0 +1,73 @@
+#pragma once
+
+/**
+ * @file span_trace.h
+ * @brief Begin/end spans around UI handlers, exportable as Chrome trace JSON.
+ *
+ * Build with -DESP32_UI_SPAN_TRACE to enable. Without it, UI_SPAN() expands to
+ * nothing and none of this is compiled.
+ *
+ * Each task that records a span gets its own fixed-size ring (ESP32_UI_SPAN_EVENTS
+ * records, up to ESP32_UI_SPAN_TASKS tasks), so recording takes no locks: a task only
+ * ever writes to its own ring. When a ring fills, the oldest records are overwritten.
+ *
+ * Call SpanTrace::dump_chrome_json(Serial) and load the output in chrome://tracing or
+ * https://ui.perfetto.dev to see which handler in a chain of virtual calls is slow.
+ * Dump while the UI is idle; records written during the dump may come out torn.
+ */
+
+#ifdef ESP32_UI_SPAN_TRACE
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#ifndef ESP32_UI_SPAN_TASKS
+#define ESP32_UI_SPAN_TASKS 4
+#endif
+
+#ifndef ESP32_UI_SPAN_EVENTS
+#define ESP32_UI_SPAN_EVENTS 256
+#endif
+
+namespace esp32_ui
+{
+  class SpanTrace
+  {
+  public:
+    static void begin(const char *name, const char *label);
+    static void end(const char *name, const char *label);
+
+    static void dump_chrome_json(Print &out);
+    static void clear();
+  };
+
+  class SpanScope
+  {
+    const char *name;
+    const char *label;
+
+  public:
+    SpanScope(const char *name, const char *label)
+        : name(name),
+          label(label)
+    {
+      SpanTrace::begin(name, label);
+    }
+
+    ~SpanScope()
+    {
+      SpanTrace::end(name, label);
+    }
+  };
+
+} // namespace esp32_ui
+
+#define UI_SPAN_CAT_(a, b) a##b
+#define UI_SPAN_CAT(a, b) UI_SPAN_CAT_(a, b)
+#define UI_SPAN(name, label) ::esp32_ui::SpanScope UI_SPAN_CAT(_ui_span_, __LINE__)(name, label)
+
+#else
+
+#define UI_SPAN(name, label)
+
+#endif
@@ -39,7 +39,11 @@ namespace esp32_ui
         value = !value;
         if (func)
         {
-          func();
+          {
+            UI_BUDGET(Callback, label);
+            func();
+          }
+          MenuStack::bump_sync_generation();
         }
         return true;
       }
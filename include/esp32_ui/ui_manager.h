@@ -3,6 +3,10 @@
 #include <memory.h>
 #include <freertos/FreeRTOS.h>
 #include <esp32_ui/canvas.h>
+#include <esp32_ui/screen_saver.h>
+#include <esp32_ui/event_trace.h>
+#include <esp32_ui/display_mirror.h>
+#include <esp32_ui/display_registry.h>
 
 // This class takes nav and sw inputs and navigates through menu stuff
 
@@ -15,11 +19,20 @@ namespace esp32_ui
     static void ui_task(void *param);
     static void display_task(void * param);
 
+    // Called every frame while the root is asleep, unless effects have been added to
+    // saver_engine, in which case the engine owns the frame buffer instead
     virtual void screen_saver() {}
+    ScreenSaverEngine saver_engine;
+    DisplayMirror *mirror = nullptr;
+
+    // Display::instance(), registered as the DisplayRegistry's primary menu port
+    DisplayPort main_port;
 
     UIState *ui_state = nullptr;
     std::unique_ptr<Canvas> root_node;
 
+    static EventTraceRecorder *trace_recorder;
+
   public:
     Canvas *root_node_ptr = nullptr;
 
@@ -35,9 +48,25 @@ namespace esp32_ui
 
     UIManager(std::unique_ptr<Canvas> root);
     static void dispatch_event(MenuEvent ev);
+    // Model data changed: re-sync the level on screen now and every other level when
+    // it's returned to
     static void request_sync();
+    // Only the level on screen needs to re-sync (an edit in progress); cached levels
+    // stay valid, since nothing has been committed
+    static void request_local_sync();
     static void request_redraw();
 
+    // Returns true (and clears the request) if a sync has been requested
+    static bool consume_sync_request();
+
+    // Every event passed to dispatch_event() is also handed to the recorder
+    // (pass nullptr to detach)
+    static void set_trace_recorder(EventTraceRecorder *recorder) { trace_recorder = recorder; }
+
+    // Stream every frame sent to the panel (and take events back) over the mirror's
+    // transport. Call before start_ui(); pass nullptr to detach.
+    void attach_mirror(DisplayMirror *m) { mirror = m; }
+
     virtual ~UIManager() = default;
   };
 
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <string.h>
+#include <type_traits>
+
+/**
+ * @file value_cell.h
+ * @brief Single-writer value that any task or core can read without tearing.
+ *
+ * Field values are written by the event dispatch task and read by the display task
+ * and by application tasks (audio, control) through getters, possibly on the other
+ * core. ValueCell<T> makes those reads safe without a mutex on the read path:
+ *
+ * - If std::atomic<T> is lock-free on the target (everything up to 32 bits on the
+ *   ESP32), the cell is just that atomic.
+ * - Otherwise (int64_t, larger structs) it is a seqlock: the writer bumps a sequence
+ *   counter around the copy, and readers retry until they see the same even sequence
+ *   number before and after theirs. Readers never block the writer, so a low-priority
+ *   reader can't cause priority inversion.
+ *
+ * There must be only one writer at a time (for fields, that's the dispatch task).
+ */
+
+namespace esp32_ui
+{
+  template <typename T>
+  class ValueCell
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "ValueCell<T> needs a trivially copyable T");
+
+  public:
+    inline static constexpr bool is_lock_free = std::atomic<T>::is_always_lock_free;
+
+    ValueCell(T initial = T{}) { store(initial); }
+
+    ValueCell(const ValueCell &) = delete;
+    ValueCell &operator=(const ValueCell &) = delete;
+
+    T load() const
+    {
+      if constexpr (is_lock_free)
+      {
+        return cell.load(std::memory_order_acquire);
+      }
+      else
+      {
+        T out;
+        uint32_t before, after;
+        do
+        {
+          before = cell.seq.load(std::memory_order_acquire);
+          memcpy(&out, (const void *)&cell.value, sizeof(T));
+          std::atomic_thread_fence(std::memory_order_acquire);
+          after = cell.seq.load(std::memory_order_relaxed);
+        } while ((before & 1) || (before != after));
+        return out;
+      }
+    }
+
+    void store(T v)
+    {
+      if constexpr (is_lock_free)
+      {
+        cell.store(v, std::memory_order_release);
+      }
+      else
+      {
+        const uint32_t s = cell.seq.load(std::memory_order_relaxed);
+        cell.seq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy((void *)&cell.value, &v, sizeof(T));
+        cell.seq.store(s + 2, std::memory_order_release);
+      }
+    }
+
+    operator T() const { return load(); }
+
+    ValueCell &operator=(T v)
+    {
+      store(v);
+      return *this;
+    }
+
+  private:
+    struct SeqLocked
+    {
+      std::atomic<uint32_t> seq{0};
+      volatile T value;
+    };
+
+    std::conditional_t<is_lock_free, std::atomic<T>, SeqLocked> cell;
+  };
+
+} // namespace esp32_ui
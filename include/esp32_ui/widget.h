@@ -1,8 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <esp32_ui/menu_base.h>
 #include <esp32_ui/element.h>
+#include <esp32_ui/layout.h>
 
 // UI logic unit. Handles child selection, focus, editing, routing,
 // and state control.
@@ -28,15 +30,28 @@ namespace esp32_ui
     std::unique_ptr<Element> linked_canvas = nullptr;
     uint8_t cursor_offset = 50;
 
+    // Column positions, refreshed by update_layout() when layout_stamp goes stale
+    struct ColumnLayout
+    {
+      uint8_t label_x;
+      uint8_t value_x; // where the ':' goes
+    };
+    mutable ColumnLayout columns{};
+    mutable LayoutStamp layout_stamp;
+
   public:
-    bool is_active = false;
-    bool is_editing = false;
+    std::atomic<bool> is_active{false};  // Read by the display task
+    std::atomic<bool> is_editing{false}; // Read by the display task
 
     Element *c_selected_element() const;
     Element *active_element();
 
     void add_submenu(std::unique_ptr<Element> submenu);
     void add_element(std::unique_ptr<Element> element);
+    // The Canvas pushed on <select>, if any
+    Element *submenu() const { return linked_canvas.get(); }
+    size_t num_elements() const { return elements.size(); }
+    Element *element_at(size_t i) const { return (i < elements.size()) ? elements[i].get() : nullptr; }
 
     Widget(const char *label = "")
         : Element(label)
@@ -58,8 +73,16 @@ namespace esp32_ui
     void set_cursor_offset(uint8_t ofs)
     {
       cursor_offset = ofs;
+      layout_stamp.invalidate();
     }
 
+    // Measures labels and places the columns; handle_draw() calls it when stale
+    virtual void update_layout(Display *d) const;
+
+    // Pixels drawn below the row origin, if more than one row (0 = one row). In
+    // page-buffer mode the Canvas uses it to pick the pages this Widget is drawn on.
+    virtual uint8_t draw_height() const { return 0; }
+
     ///////////////////////////////////////////////////////////////////
     // Event Handlers
     ///////////////////////////////////////////////////////////////////
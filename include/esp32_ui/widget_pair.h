@@ -9,6 +9,14 @@ namespace esp32_ui
     inline static constexpr uint8_t LEFT_INDEX = 0;
     inline static constexpr uint8_t RIGHT_INDEX = 1;
 
+    struct PairLayout
+    {
+      uint8_t left_x;
+      uint8_t right_x;
+      uint8_t close_x; // closing bracket
+    };
+    mutable PairLayout pair_columns{};
+
   public:
     WidgetPair(const char *label,
                std::unique_ptr<Element> &&left,
@@ -40,6 +48,7 @@ namespace esp32_ui
     Widget *left();
     Widget *right();
 
+    void update_layout(Display *d) const override;
     void handle_draw(Display *d) const override;
     virtual bool can_handle(const MenuEvent &ev) const override;
     virtual bool handle_event(const MenuEvent &ev) override;
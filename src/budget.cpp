@@ -0,0 +1,118 @@
+#include <esp32_ui/budget.h>
+
+#ifdef ESP32_UI_EXEC_BUDGETS
+
+#include <atomic>
+#include <mutex>
+#include <esp32_ui/value_cell.h>
+
+namespace esp32_ui
+{
+  namespace
+  {
+    constexpr size_t NUM_KINDS = static_cast<size_t>(BudgetKind::NUM_KINDS);
+
+    std::atomic<uint32_t> budgets[NUM_KINDS] = {
+        1000,  // Callback
+        200,   // Getter
+        200,   // Setter
+        1000,  // Enter
+        1000,  // Exit
+        5000,  // Dispatch
+        10000, // Sync
+        20000, // Draw
+    };
+
+    ValueCell<MenuEvent> current_event;
+
+    // Overruns are rare, so the log itself can afford a lock
+    std::mutex log_mutex;
+    BudgetOverrun overrun_log[ESP32_UI_BUDGET_LOG];
+    uint32_t n_overruns = 0;
+  } // namespace
+
+  void ExecBudget::set_budget(BudgetKind kind, uint32_t budget_us)
+  {
+    if (kind < BudgetKind::NUM_KINDS)
+    {
+      budgets[size_t(kind)].store(budget_us, std::memory_order_relaxed);
+    }
+  }
+
+  uint32_t ExecBudget::get_budget(BudgetKind kind)
+  {
+    return (kind < BudgetKind::NUM_KINDS) ? budgets[size_t(kind)].load(std::memory_order_relaxed) : 0;
+  }
+
+  void ExecBudget::set_current_event(const MenuEvent &ev)
+  {
+    current_event.store(ev);
+  }
+
+  void ExecBudget::check(BudgetKind kind, const char *label, uint32_t elapsed_us)
+  {
+    const uint32_t budget = get_budget(kind);
+    if (!budget || (elapsed_us <= budget))
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(log_mutex);
+    overrun_log[n_overruns % ESP32_UI_BUDGET_LOG] = BudgetOverrun{kind, label, current_event.load(), elapsed_us, budget};
+    ++n_overruns;
+  }
+
+  size_t ExecBudget::read_overruns(BudgetOverrun *out, size_t max_records)
+  {
+    std::lock_guard<std::mutex> lock(log_mutex);
+    const size_t logged = (n_overruns < ESP32_UI_BUDGET_LOG) ? n_overruns : ESP32_UI_BUDGET_LOG;
+    const size_t n = (logged < max_records) ? logged : max_records;
+
+    // The newest n records, oldest first
+    for (size_t i = 0; i < n; ++i)
+    {
+      out[i] = overrun_log[(n_overruns - n + i) % ESP32_UI_BUDGET_LOG];
+    }
+    return n;
+  }
+
+  uint32_t ExecBudget::overrun_count()
+  {
+    std::lock_guard<std::mutex> lock(log_mutex);
+    return n_overruns;
+  }
+
+  void ExecBudget::clear()
+  {
+    std::lock_guard<std::mutex> lock(log_mutex);
+    n_overruns = 0;
+  }
+
+  const char *ExecBudget::kind_to_str(BudgetKind kind)
+  {
+    switch (kind)
+    {
+    case BudgetKind::Callback:
+      return "Callback";
+    case BudgetKind::Getter:
+      return "Getter";
+    case BudgetKind::Setter:
+      return "Setter";
+    case BudgetKind::Enter:
+      return "Enter";
+    case BudgetKind::Exit:
+      return "Exit";
+    case BudgetKind::Dispatch:
+      return "Dispatch";
+    case BudgetKind::Sync:
+      return "Sync";
+    case BudgetKind::Draw:
+      return "Draw";
+    default:
+      return "UNKNOWN";
+    }
+  }
+
+} // namespace esp32_ui
+
+#endif
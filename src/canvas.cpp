@@ -1,6 +1,9 @@
+#include <algorithm>
 #include <esp32_ui/canvas.h>
 #include <esp32_ui/event_router.h>
 #include <esp32_ui/field.h>
+#include <esp32_ui/framebuffer.h>
+#include <esp32_ui/span_trace.h>
 
 namespace esp32_ui
 {
@@ -16,6 +19,7 @@ namespace esp32_ui
 
     widget.get()->add_element(std::move(element));
     widgets.push_back(std::move(widget));
+    layout_stamp.invalidate();
 
     return raw_ptr;
   }
@@ -27,6 +31,7 @@ namespace esp32_ui
 
     widget.get()->add_submenu(std::move(canvas));
     widgets.push_back(std::move(widget));
+    layout_stamp.invalidate();
 
     return raw_ptr;
   }
@@ -36,6 +41,7 @@ namespace esp32_ui
     auto *raw_ptr = widget.get();
 
     widgets.push_back(std::move(widget));
+    layout_stamp.invalidate();
 
     return raw_ptr;
   }
@@ -88,6 +94,16 @@ namespace esp32_ui
     }
   }
 
+  // Same data as when we left, so only the active widget needs its focus back
+  void Canvas::handle_resume()
+  {
+    menuprintf("%s Canvas::handle_resume\n", label);
+    if (auto *widget = active_widget())
+    {
+      widget->handle_get_focus();
+    }
+  }
+
   void Canvas::handle_exit()
   {
     menuprintf("%s Canvas::handle_exit\n", label);
@@ -165,6 +181,16 @@ namespace esp32_ui
     cursor = next_index;
   }
 
+  bool Canvas::set_cursor(size_t i)
+  {
+    if (i >= widgets.size())
+    {
+      return false;
+    }
+    cursor = static_cast<int8_t>(i);
+    return true;
+  }
+
   bool Canvas::handle_event(const MenuEvent &ev)
   {
     // Route bound accessory controls directly to active widget
@@ -197,6 +223,7 @@ namespace esp32_ui
 
   void Canvas::handle_sync()
   {
+    UI_SPAN("Canvas::handle_sync", label);
     menuprintf("%s Canvas::handle_sync\n", label);
     auto *w = active_widget();
 
@@ -219,37 +246,55 @@ namespace esp32_ui
     }
   }
 
+  void Canvas::update_layout(Display *d) const
+  {
+    layout_stamp.mark_current();
+
+    // Rows start one pitch down, below the header
+    const uint8_t pitch = fixed_cursor ? FIXED_CURSOR_ROW_PITCH : ROW_PITCH;
+    rows.resize(widgets.size());
+    for (size_t n = 0; n < rows.size(); ++n)
+    {
+      const size_t y = (n + 1) * pitch;
+      rows[n] = RowRect{uint8_t((y < UINT8_MAX) ? y : UINT8_MAX), pitch};
+    }
+  }
+
   void Canvas::handle_draw(Display *d) const
   {
+    UI_SPAN("Canvas::handle_draw", label);
+    if (layout_stamp.is_stale() || (rows.size() != widgets.size()))
+    {
+      update_layout(d);
+    }
+
     if (header)
     {
       header->handle_draw(d);
     }
 
-    size_t num_widgets = widgets.size();
-    if (fixed_cursor)
+    const bool invert_highlight = ui_state->invert_highlight();
+    const size_t num_widgets = widgets.size();
+    for (size_t n = 0; n < num_widgets; ++n)
     {
-      for (size_t n = 0; n < num_widgets; ++n)
+      // With a fixed cursor the selected widget is always drawn in the first row
+      const size_t index = fixed_cursor ? (selected_index() + n) % num_widgets : n;
+      auto &child = widgets[index];
+      if (child)
       {
-        d->setCursor(0, n * 8 + 8);
-        uint8_t active_index = (selected_index() + n) % num_widgets;
-        auto &child = widgets[active_index];
-        if (child)
+        if constexpr (Display::page_buffered)
         {
-          child.get()->handle_draw(d);
+          // Only the rows that land on the page being drawn
+          if (!d->rows_in_buffer(rows[n].y, std::max(rows[n].h, child->draw_height())))
+          {
+            continue;
+          }
         }
-      }
-    }
-    else
-    {
-      // TODO: bring these changes back into library, and handle this more goodly
-      for (size_t n = 0; n < widgets.size(); ++n)
-      {
-        d->setCursor(0, n * 12 + 12);
-        auto &child = widgets[n];
-        if (child)
+        d->setCursor(0, rows[n].y);
+        child.get()->handle_draw(d);
+        if (invert_highlight && child->is_active)
         {
-          child.get()->handle_draw(d);
+          FrameBuffer(d).invert_rows(rows[n].y, rows[n].h);
         }
       }
     }
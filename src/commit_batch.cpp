@@ -0,0 +1,102 @@
+#include <string.h>
+#include <esp32_ui/commit_batch.h>
+
+namespace esp32_ui
+{
+  namespace
+  {
+    // a + b for two delta records of the same type; floats travel as their bits
+    int64_t add_deltas(Element::FieldDataType type, int64_t a, int64_t b)
+    {
+      if (type == Element::FieldDataType::Float)
+      {
+        uint32_t bits_a = uint32_t(a), bits_b = uint32_t(b);
+        float fa, fb;
+        memcpy(&fa, &bits_a, sizeof(fa));
+        memcpy(&fb, &bits_b, sizeof(fb));
+        const float sum = fa + fb;
+        uint32_t bits;
+        memcpy(&bits, &sum, sizeof(bits));
+        return int64_t(bits);
+      }
+
+      int64_t sum;
+      if (__builtin_add_overflow(a, b, &sum))
+      {
+        return (b > 0) ? INT64_MAX : INT64_MIN;
+      }
+      return sum;
+    }
+  } // namespace
+
+  CommitBatch *CommitBatch::instance()
+  {
+    static CommitBatch inst;
+    return &inst;
+  }
+
+  bool CommitBatch::begin()
+  {
+    if (!handler)
+    {
+      return false;
+    }
+
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    if (owner.load(std::memory_order_acquire) != self)
+    {
+      // Another task's transaction holds the batch until it has been delivered
+      txn_mutex.lock();
+      owner.store(self, std::memory_order_release);
+    }
+    ++depth;
+    return true;
+  }
+
+  void CommitBatch::end()
+  {
+    assert(depth && (owner.load() == xTaskGetCurrentTaskHandle()) && "CommitBatch::end() without begin()");
+    if (--depth)
+    {
+      return;
+    }
+
+    if (!records.empty() && handler)
+    {
+      handler(records.data(), records.size());
+    }
+    records.clear();
+    slots.clear();
+
+    owner.store(nullptr, std::memory_order_release);
+    txn_mutex.unlock();
+  }
+
+  bool CommitBatch::record(uint16_t field_id, Element::FieldDataType type, int64_t value, bool delta)
+  {
+    if (!field_id || (owner.load(std::memory_order_acquire) != xTaskGetCurrentTaskHandle()))
+    {
+      return false;
+    }
+
+    auto slot = slots.find(field_id);
+    if (slot != slots.end())
+    {
+      Record &r = records[slot->second];
+      if (delta && r.delta && (r.type == type))
+      {
+        r.value = add_deltas(type, r.value, value);
+      }
+      else
+      {
+        r = Record{field_id, type, value, delta};
+      }
+      return true;
+    }
+
+    slots.emplace(field_id, uint16_t(records.size()));
+    records.push_back(Record{field_id, type, value, delta});
+    return true;
+  }
+
+} // namespace esp32_ui
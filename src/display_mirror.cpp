@@ -0,0 +1,180 @@
+#include <string.h>
+#include <algorithm>
+#include <esp32_ui/display_mirror.h>
+#include <esp32_ui/ui_manager.h>
+
+namespace esp32_ui
+{
+  namespace
+  {
+    // sync, type, len, seq, cols, rows, n, ..., sum
+    inline constexpr size_t FRAME_OVERHEAD = 10;
+    // index, mask, up to 8 delta bytes
+    inline constexpr size_t MAX_TILE_SIZE = 11;
+
+    inline void put_u16(std::vector<uint8_t> &v, size_t at, uint16_t x)
+    {
+      v[at] = x & 0xFF;
+      v[at + 1] = x >> 8;
+    }
+  } // namespace
+
+  DisplayMirror::DisplayMirror(MirrorTransport &transport,
+                               uint16_t max_bytes_per_frame,
+                               uint8_t frame_divider)
+      : transport(transport),
+        max_bytes(max_bytes_per_frame < FRAME_OVERHEAD + MAX_TILE_SIZE ? FRAME_OVERHEAD + MAX_TILE_SIZE : max_bytes_per_frame),
+        divider(frame_divider ? frame_divider : 1)
+  {
+    packet.reserve(max_bytes);
+  }
+
+  void DisplayMirror::request_full_frame()
+  {
+    // The receiver starts from a blank screen, so a forgotten shadow resends all
+    // non-blank tiles
+    std::fill(shadow.begin(), shadow.end(), 0);
+  }
+
+  void DisplayMirror::publish(Display *d)
+  {
+    if (++divider_count < divider)
+    {
+      return;
+    }
+    divider_count = 0;
+
+    const uint8_t *buf = d->getBufferPtr();
+    const uint8_t cols = d->getBufferTileWidth();
+    const uint8_t rows = d->getBufferTileHeight();
+    const uint16_t num_tiles = uint16_t(cols) * rows;
+    if (!buf || !num_tiles)
+    {
+      return;
+    }
+
+    if (shadow.size() != size_t(num_tiles) * 8)
+    {
+      shadow.assign(size_t(num_tiles) * 8, 0);
+      next_tile = 0;
+    }
+
+    size_t budget = max_bytes;
+    const size_t writable = transport.writable();
+    if (writable < budget)
+    {
+      budget = writable;
+    }
+    if (budget < FRAME_OVERHEAD + MAX_TILE_SIZE)
+    {
+      return;
+    }
+
+    packet.clear();
+    packet.push_back(FRAME_SYNC);
+    packet.push_back('F');
+    packet.push_back(0); // len
+    packet.push_back(0);
+    packet.push_back(seq);
+    packet.push_back(cols);
+    packet.push_back(rows);
+    packet.push_back(0); // n
+    packet.push_back(0);
+
+    uint16_t n = 0;
+    uint16_t tile = next_tile;
+    for (uint16_t scanned = 0; scanned < num_tiles; ++scanned, tile = (tile + 1) % num_tiles)
+    {
+      // U8g2 tile layout: tile (row, col) is 8 consecutive bytes at row * cols * 8 + col * 8
+      const size_t ofs = size_t(tile) * 8;
+      if (memcmp(buf + ofs, &shadow[ofs], 8) == 0)
+      {
+        continue;
+      }
+
+      if (packet.size() + MAX_TILE_SIZE + 1 > budget)
+      {
+        break;
+      }
+
+      uint8_t delta[8];
+      uint8_t mask = 0;
+      for (uint8_t i = 0; i < 8; ++i)
+      {
+        delta[i] = buf[ofs + i] ^ shadow[ofs + i];
+        if (delta[i])
+        {
+          mask |= 1 << i;
+        }
+      }
+
+      packet.push_back(tile & 0xFF);
+      packet.push_back(tile >> 8);
+      packet.push_back(mask);
+      for (uint8_t i = 0; i < 8; ++i)
+      {
+        if (delta[i])
+        {
+          packet.push_back(delta[i]);
+        }
+      }
+
+      memcpy(&shadow[ofs], buf + ofs, 8);
+      ++n;
+    }
+    next_tile = tile;
+
+    if (!n)
+    {
+      return;
+    }
+
+    put_u16(packet, 2, packet.size() - 4);
+    put_u16(packet, 7, n);
+
+    uint8_t sum = 0;
+    for (size_t i = 4; i < packet.size(); ++i)
+    {
+      sum += packet[i];
+    }
+    packet.push_back(sum);
+
+    total_bytes += transport.write(packet.data(), packet.size());
+    ++seq;
+  }
+
+  void DisplayMirror::poll_input()
+  {
+    int c;
+    while ((c = transport.read()) >= 0)
+    {
+      const uint8_t b = static_cast<uint8_t>(c);
+      if ((rx_len == 0) && (b != EVENT_SYNC))
+      {
+        continue;
+      }
+      if ((rx_len == 1) && (b != 'E'))
+      {
+        rx_len = (b == EVENT_SYNC) ? 1 : 0;
+        continue;
+      }
+
+      rx[rx_len++] = b;
+      if (rx_len < sizeof(rx))
+      {
+        continue;
+      }
+
+      rx_len = 0;
+      if ((rx[2] ^ rx[3] ^ rx[4]) != rx[5])
+      {
+        continue;
+      }
+
+      UIManager::dispatch_event(MenuEvent{static_cast<MenuEvent::Source>(rx[2]),
+                                          static_cast<MenuEvent::Type>(rx[3]),
+                                          rx[4]});
+    }
+  }
+
+} // namespace esp32_ui
@@ -0,0 +1,214 @@
+#include <esp32_ui/display_registry.h>
+#include <esp32_ui/event_router.h>
+#include <esp32_ui/span_trace.h>
+
+namespace esp32_ui
+{
+  void DisplayPort::begin()
+  {
+    if (display)
+    {
+      display->start_display();
+    }
+#if defined(DISPLAY_BASE)
+    else
+    {
+      panel->begin();
+    }
+#endif
+  }
+
+  Element *DisplayPort::shown() const
+  {
+    if (!display)
+    {
+      return nullptr;
+    }
+    Element *node = get_root();
+    return node ? node : EventRouter::instance()->top_menu();
+  }
+
+  void DisplayPort::draw_frame()
+  {
+    if (display)
+    {
+      Element *node = shown();
+      if constexpr (Display::page_buffered)
+      {
+        // nextPage() sends each page as it's finished
+        display->firstPage();
+        do
+        {
+          if (node)
+          {
+            node->handle_draw(display);
+          }
+        } while (display->nextPage());
+      }
+      else
+      {
+        display->clearBuffer();
+        if (node)
+        {
+          node->handle_draw(display);
+        }
+        UI_SPAN("sendBuffer", name);
+        display->sendBuffer();
+      }
+      ++frames;
+      return;
+    }
+
+#if defined(DISPLAY_BASE)
+    panel->clearBuffer();
+    render(*panel);
+    {
+      UI_SPAN("sendBuffer", name);
+      panel->sendBuffer();
+    }
+    ++frames;
+#endif
+  }
+
+  bool DisplayPort::take_frame(TickType_t now)
+  {
+    if ((now - last_frame) < pdMS_TO_TICKS(refresh_ms))
+    {
+      return false;
+    }
+    if (!take_dirty())
+    {
+      return false;
+    }
+    last_frame = now;
+    return true;
+  }
+
+  DisplayRegistry *DisplayRegistry::instance()
+  {
+    static DisplayRegistry inst;
+    return &inst;
+  }
+
+  int8_t DisplayRegistry::add(DisplayPort *port)
+  {
+    if (!port || started || (count >= MAX_DISPLAYS))
+    {
+      return -1;
+    }
+
+    ports[count] = port;
+    return static_cast<int8_t>(count++);
+  }
+
+  int8_t DisplayRegistry::set_primary(DisplayPort *port)
+  {
+    if (!port || !port->is_menu() || primary_port)
+    {
+      return -1;
+    }
+
+    const int8_t id = add(port);
+    if (id >= 0)
+    {
+      primary_port = port;
+    }
+    return id;
+  }
+
+  void DisplayRegistry::mark_dirty(uint8_t id)
+  {
+    if (auto *port = get(id))
+    {
+      port->mark_dirty();
+    }
+  }
+
+  void DisplayRegistry::mark_all_dirty()
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      ports[i]->mark_dirty();
+    }
+  }
+
+  void DisplayRegistry::mark_menus_dirty()
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (ports[i]->is_menu())
+      {
+        ports[i]->mark_dirty();
+      }
+    }
+  }
+
+  void DisplayRegistry::start()
+  {
+    if (started)
+    {
+      return;
+    }
+    started = true;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      DisplayPort *port = ports[i];
+      if (port->is_menu())
+      {
+        continue;
+      }
+      xTaskCreate(
+          &DisplayRegistry::port_task,
+          port->name,
+          1024 * 4,
+          port,
+          port->priority,
+          &port->task);
+    }
+  }
+
+  void DisplayRegistry::begin_menus()
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (ports[i]->is_menu())
+      {
+        ports[i]->begin();
+      }
+    }
+  }
+
+  void DisplayRegistry::draw_menus()
+  {
+    const TickType_t now = xTaskGetTickCount();
+    for (size_t i = 0; i < count; ++i)
+    {
+      DisplayPort *port = ports[i];
+      if (port->is_menu() && (port != primary_port) && port->take_frame(now))
+      {
+        port->draw_frame();
+      }
+    }
+  }
+
+  void DisplayRegistry::port_task(void *param)
+  {
+    DisplayPort *port = static_cast<DisplayPort *>(param);
+    port->begin();
+
+    const TickType_t xTaskFrequency = pdMS_TO_TICKS(port->refresh_ms);
+    TickType_t xLastWakeTime{xTaskGetTickCount()};
+
+    while (1)
+    {
+      if (port->take_dirty())
+      {
+        port->draw_frame();
+      }
+
+      xTaskDelayUntil(&xLastWakeTime, xTaskFrequency);
+    }
+  }
+
+} // namespace esp32_ui
@@ -0,0 +1,135 @@
+#include <Arduino.h>
+#include <esp32_ui/edit_journal.h>
+#include <esp32_ui/field.h>
+#include <esp32_ui/ui_manager.h>
+
+namespace esp32_ui
+{
+  EditJournal *EditJournal::instance()
+  {
+    static EditJournal inst;
+    return &inst;
+  }
+
+  void EditJournal::record(FieldBase *field, int64_t old_raw, int64_t new_raw)
+  {
+    if (!field || (old_raw == new_raw) || !is_recording())
+    {
+      return;
+    }
+
+    const uint32_t now = millis();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // A new edit makes the redo history meaningless
+    if (newest != cursor)
+    {
+      newest = cursor;
+      open_entry = false;
+    }
+
+    if (open_entry && (cursor != oldest))
+    {
+      Entry &last = slot(cursor - 1);
+      if ((last.field == field) && (now - last.ts_ms <= coalesce_ms.load(std::memory_order_relaxed)))
+      {
+        last.new_raw = new_raw;
+        last.ts_ms = now;
+        if (last.new_raw == last.old_raw)
+        {
+          // Turned back to where it started; nothing left to undo
+          --cursor;
+          newest = cursor;
+          open_entry = false;
+        }
+        return;
+      }
+    }
+
+    slot(cursor) = Entry{field, old_raw, new_raw, now};
+    ++cursor;
+    newest = cursor;
+    if (cursor - oldest > CAPACITY)
+    {
+      oldest = cursor - CAPACITY;
+    }
+    open_entry = true;
+  }
+
+  bool EditJournal::undo()
+  {
+    Entry e;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (cursor == oldest)
+      {
+        return false;
+      }
+      --cursor;
+      e = slot(cursor);
+      open_entry = false;
+    }
+
+    // Outside the lock: the setter may take a while
+    {
+      Pause pause;
+      e.field->restore_raw(e.old_raw);
+    }
+    UIManager::schedule_redraw();
+    return true;
+  }
+
+  bool EditJournal::redo()
+  {
+    Entry e;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (cursor == newest)
+      {
+        return false;
+      }
+      e = slot(cursor);
+      ++cursor;
+      open_entry = false;
+    }
+
+    {
+      Pause pause;
+      e.field->restore_raw(e.new_raw);
+    }
+    UIManager::schedule_redraw();
+    return true;
+  }
+
+  bool EditJournal::can_undo() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return cursor != oldest;
+  }
+
+  bool EditJournal::can_redo() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return cursor != newest;
+  }
+
+  size_t EditJournal::undo_depth() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return cursor - oldest;
+  }
+
+  size_t EditJournal::redo_depth() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return newest - cursor;
+  }
+
+  void EditJournal::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    oldest = cursor = newest = 0;
+    open_entry = false;
+  }
+
+} // namespace esp32_ui
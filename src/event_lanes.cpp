@@ -0,0 +1,242 @@
+#include <esp32_ui/event_lanes.h>
+
+namespace esp32_ui
+{
+  EventLanes *EventLanes::instance()
+  {
+    static EventLanes inst;
+    return &inst;
+  }
+
+  EventLanes::EventLanes()
+  {
+    lanes[size_t(Lane::Control)].depth = 8;
+    lanes[size_t(Lane::Control)].policy = DropPolicy::DropNewest;
+    lanes[size_t(Lane::Nav)].depth = 16;
+    lanes[size_t(Lane::Nav)].policy = DropPolicy::DropOldest;
+    lanes[size_t(Lane::System)].depth = 4;
+    lanes[size_t(Lane::System)].policy = DropPolicy::DropNewest;
+    lanes[size_t(Lane::BestEffort)].depth = 8;
+    lanes[size_t(Lane::BestEffort)].policy = DropPolicy::DropOldest;
+
+    for (auto &l : source_lane)
+    {
+      l.store(NO_LANE);
+    }
+    map_source(MenuEvent::Source::Gate, Lane::BestEffort);
+  }
+
+  bool EventLanes::configure(Lane lane, uint8_t depth, DropPolicy policy)
+  {
+    if (is_started() || !depth)
+    {
+      return false;
+    }
+
+    lanes[size_t(lane)].depth = depth;
+    lanes[size_t(lane)].policy = policy;
+    return true;
+  }
+
+  uint8_t EventLanes::source_slot(MenuEvent::Source src)
+  {
+    if (src == MenuEvent::Source::NoSource)
+    {
+      return 0;
+    }
+    return __builtin_ctz(static_cast<unsigned>(src)) + 1;
+  }
+
+  void EventLanes::map_source(MenuEvent::Source src, Lane lane)
+  {
+    const uint8_t slot = source_slot(src);
+    if (slot < source_lane.size())
+    {
+      source_lane[slot].store(static_cast<uint8_t>(lane));
+    }
+  }
+
+  void EventLanes::unmap_source(MenuEvent::Source src)
+  {
+    const uint8_t slot = source_slot(src);
+    if (slot < source_lane.size())
+    {
+      source_lane[slot].store(NO_LANE);
+    }
+  }
+
+  EventLanes::Lane EventLanes::classify(const MenuEvent &ev) const
+  {
+    const uint8_t slot = source_slot(ev.source);
+    if (slot < source_lane.size())
+    {
+      const uint8_t mapped = source_lane[slot].load();
+      if (mapped != NO_LANE)
+      {
+        return static_cast<Lane>(mapped);
+      }
+    }
+
+    switch (ev.type)
+    {
+    case MenuEvent::Type::NavUp:
+    case MenuEvent::Type::NavDown:
+    case MenuEvent::Type::NavLeft:
+    case MenuEvent::Type::NavRight:
+      return Lane::Nav;
+    case MenuEvent::Type::Draw:
+    case MenuEvent::Type::Sync:
+    case MenuEvent::Type::NoType:
+      return Lane::System;
+    default:
+      return Lane::Control;
+    }
+  }
+
+  void EventLanes::start()
+  {
+    if (is_started())
+    {
+      return;
+    }
+
+    UBaseType_t total = 0;
+    for (auto &l : lanes)
+    {
+      l.queue = xQueueCreate(l.depth, sizeof(MenuEvent));
+      total += l.depth;
+    }
+    available = xSemaphoreCreateCounting(total, 0);
+    started.store(true, std::memory_order_release);
+  }
+
+  bool EventLanes::push(const MenuEvent &ev)
+  {
+    LaneState &l = lanes[size_t(classify(ev))];
+    if (!is_started())
+    {
+      ++l.dropped;
+      return false;
+    }
+
+    if (xQueueSend(l.queue, &ev, 0) == pdPASS)
+    {
+      xSemaphoreGive(available);
+    }
+    else
+    {
+      ++l.dropped;
+      if (l.policy == DropPolicy::DropNewest)
+      {
+        return false;
+      }
+
+      // Swap the oldest event for this one; the number of queued events is unchanged
+      MenuEvent discard;
+      const bool made_room = (xQueueReceive(l.queue, &discard, 0) == pdPASS);
+      if (xQueueSend(l.queue, &ev, 0) != pdPASS)
+      {
+        // Another producer took the slot
+        return false;
+      }
+      if (!made_room)
+      {
+        // The consumer emptied a slot in between
+        xSemaphoreGive(available);
+      }
+    }
+
+    ++l.queued;
+    const uint32_t waiting = uxQueueMessagesWaiting(l.queue);
+    uint32_t hw = l.high_water.load(std::memory_order_relaxed);
+    while ((waiting > hw) && !l.high_water.compare_exchange_weak(hw, waiting, std::memory_order_relaxed))
+    {
+    }
+    return true;
+  }
+
+  bool EventLanes::pop(MenuEvent &ev, TickType_t wait)
+  {
+    if (!is_started())
+    {
+      return false;
+    }
+
+    // `available` is only a wake-up hint: the lanes themselves are always scanned, so
+    // a producer racing with us (DropOldest) can delay an event but never strand it
+    if (take_highest(ev))
+    {
+      xSemaphoreTake(available, 0);
+      return true;
+    }
+
+    if (!wait || (xSemaphoreTake(available, wait) != pdTRUE))
+    {
+      return false;
+    }
+    return take_highest(ev);
+  }
+
+  size_t EventLanes::pending() const
+  {
+    if (!is_started())
+    {
+      return 0;
+    }
+
+    size_t n = 0;
+    for (const auto &l : lanes)
+    {
+      n += uxQueueMessagesWaiting(l.queue);
+    }
+    return n;
+  }
+
+  bool EventLanes::take_highest(MenuEvent &ev)
+  {
+    for (auto &l : lanes)
+    {
+      if (xQueueReceive(l.queue, &ev, 0) == pdTRUE)
+      {
+        ++l.dispatched;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  EventLanes::LaneStats EventLanes::stats(Lane lane) const
+  {
+    const LaneState &l = lanes[size_t(lane)];
+    return LaneStats{l.queued.load(), l.dispatched.load(), l.dropped.load(), l.high_water.load()};
+  }
+
+  void EventLanes::reset_stats()
+  {
+    for (auto &l : lanes)
+    {
+      l.queued = 0;
+      l.dispatched = 0;
+      l.dropped = 0;
+      l.high_water = 0;
+    }
+  }
+
+  const char *EventLanes::lane_to_str(Lane lane)
+  {
+    switch (lane)
+    {
+    case Lane::Control:
+      return "Control";
+    case Lane::Nav:
+      return "Nav";
+    case Lane::System:
+      return "System";
+    case Lane::BestEffort:
+      return "BestEffort";
+    default:
+      return "UNKNOWN";
+    }
+  }
+
+} // namespace esp32_ui
@@ -1,7 +1,20 @@
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include <esp32_ui/event_router.h>
+#include <esp32_ui/bang.h>
+#include <esp32_ui/canvas.h>
+#include <esp32_ui/span_trace.h>
 
 namespace esp32_ui
 {
+  namespace
+  {
+    int8_t cursor_of(const Element *el)
+    {
+      return (el->base_type() == BaseType::Canvas) ? static_cast<const Canvas *>(el)->get_cursor() : -1;
+    }
+  } // namespace
+
   ////////////////////////////////////////////////////////////////////////////////
   // MenuStack implementation
   ////////////////////////////////////////////////////////////////////////////////
@@ -9,18 +22,15 @@ namespace esp32_ui
   bool MenuStack::push(Element *el)
   {
     menuprintf("MenuStack::push %s\n", el->label);
-    if (depth >= STACK_SIZE)
+    if (full())
     {
+      menuprintf("MenuStack full (%u levels), %s not pushed\n", unsigned(limit), el->label);
       return false;
     }
 
-    if (stack[depth] != el)
-    {
-      stack[depth] = el;
-      ++depth;
-    }
+    levels.push_back(Level{el, cursor_of(el), 0});
     menuprintf("MenuStack::top now %s\n", top() ? top()->label : "nullptr");
-    return top();
+    return true;
   }
 
   // Pop the top element off the stack
@@ -28,35 +38,37 @@ namespace esp32_ui
   // there's a valid reason you'd want to do that? I dunno, I'm not your mom), so be careful
   Element *MenuStack::pop()
   {
-    if (depth == 0)
+    if (levels.empty())
     {
       return nullptr;
     }
 
     menuprintf("MenuStack::pop, removing %s\n", top() ? top()->label : "nullptr");
-    --depth;
-    stack[depth] = nullptr;
+    levels.pop_back();
     return top();
   }
 
   // Get a pointer to the top element of the stack
   Element *MenuStack::top() const
   {
-    if (depth > 0)
-    {
-      return stack[depth - 1];
-    }
-    return nullptr;
+    return levels.empty() ? nullptr : levels.back().el;
   }
 
   // Get a pointer to the bottom element of the stack
   Element *MenuStack::root() const
   {
-    if (depth > 0)
+    return levels.empty() ? nullptr : levels.front().el;
+  }
+
+  bool MenuStack::set_max_depth(size_t depth)
+  {
+    if (!depth || (depth < levels.size()))
     {
-      return stack[0];
+      return false;
     }
-    return nullptr;
+    limit = depth;
+    levels.reserve(limit);
+    return true;
   }
 
   ////////////////////////////////////////////////////////////////////////////////
@@ -72,6 +84,10 @@ namespace esp32_ui
   bool EventRouter::bind_popup(MenuEvent::Source src, uint8_t idx, Element *el)
   {
     bindings[1][{src, idx}] = el;
+    if (auto *slot = realtime_slot(src, idx))
+    {
+      slot->popup.store(true, std::memory_order_release);
+    }
     return true;
   }
 
@@ -79,6 +95,10 @@ namespace esp32_ui
   bool EventRouter::unbind_popup(MenuEvent::Source src, uint8_t idx)
   {
     bindings[1].erase({src, idx});
+    if (auto *slot = realtime_slot(src, idx))
+    {
+      slot->popup.store(false, std::memory_order_release);
+    }
     return true;
   }
 
@@ -87,12 +107,40 @@ namespace esp32_ui
   {
     el->register_event_listener(MenuEvent{src, MenuEvent::Type::AnyAndAll, idx});
     bindings[0][{src, idx}] = el;
+    if (auto *slot = realtime_slot(src, idx))
+    {
+      // Rebinding with bind() takes the input back to the queued path
+      slot->target.store(nullptr);
+    }
+    return true;
+  }
+
+  bool EventRouter::bind_realtime(MenuEvent::Source src, uint8_t idx, Bang *el)
+  {
+    auto *slot = realtime_slot(src, idx);
+    if (!slot || !el)
+    {
+      return false;
+    }
+
+    bind(src, idx, el);
+    slot->target.store(el);
     return true;
   }
 
   // Stops filtering out specific events pre-dispatch
   bool EventRouter::unbind(MenuEvent::Source source, uint8_t idx)
   {
+    if (auto *slot = realtime_slot(source, idx))
+    {
+      // The producer bumps running before it loads the target, so once this sees 0
+      // no handler can still be using the old one
+      slot->target.store(nullptr);
+      while (slot->running.load())
+      {
+        vTaskDelay(1);
+      }
+    }
     Element *el = static_cast<Element *>(bindings[0][{source, idx}]);
     el->unregister_event_listener(MenuEvent{source, MenuEvent::Type::AnyAndAll, idx});
     bindings[0].erase({source, idx});
@@ -104,6 +152,7 @@ namespace esp32_ui
   // something bad happens.
   void EventRouter::dispatch(const MenuEvent &ev)
   {
+    UI_SPAN("EventRouter::dispatch", event_type_to_str(ev.type));
 
     Element *top = nullptr;
     {
@@ -172,13 +221,17 @@ namespace esp32_ui
       return false;
     }
 
-    if (top_menu())
+    if (auto *level = menu_stack.top_level())
     {
-      top_menu()->handle_exit();
+      level->el->handle_exit();
+      // Whatever the exit itself committed is already on screen at this level
+      level->cursor = cursor_of(level->el);
+      level->sync_gen = MenuStack::sync_generation();
     }
     menu_stack.push(el);
 
-    top_menu()->handle_enter();
+    el->handle_enter();
+    menu_stack.top_level()->sync_gen = MenuStack::sync_generation();
     return true;
   }
 
@@ -199,8 +252,24 @@ namespace esp32_ui
     top_menu()->handle_exit();
 
     menu_stack.pop();
-    assert(top_menu() && "You popped your root");
-    top_menu()->handle_enter();
+    auto *level = menu_stack.top_level();
+    assert(level && "You popped your root");
+
+    if ((level->cursor >= 0) && (level->el->base_type() == BaseType::Canvas))
+    {
+      static_cast<Canvas *>(level->el)->set_cursor(level->cursor);
+    }
+
+    // Nothing changed since this level was last synced: just refocus
+    if (level->sync_gen == MenuStack::sync_generation())
+    {
+      level->el->handle_resume();
+    }
+    else
+    {
+      level->el->handle_enter();
+    }
+    level->sync_gen = MenuStack::sync_generation();
 
     return true;
   }
@@ -233,10 +302,69 @@ namespace esp32_ui
 
     menu_stack.push(el);
     el->handle_enter();
+    menu_stack.top_level()->sync_gen = MenuStack::sync_generation();
 
     return popped;
   }
 
+  bool EventRouter::jump_to(const uint8_t *path, size_t n, bool open_last)
+  {
+    std::lock_guard<std::mutex> lock(stack_mutex);
+    Element *root = root_menu();
+    if (!root || (root->base_type() != BaseType::Canvas) || (n && !path))
+    {
+      return false;
+    }
+
+    // Resolve the whole path before touching the stack
+    std::vector<Element *> levels{root};
+    levels.reserve(n + 1);
+    Canvas *canvas = static_cast<Canvas *>(root);
+    for (size_t i = 0; i < n; ++i)
+    {
+      Widget *w = canvas->widget_at(path[i]);
+      if (!w)
+      {
+        return false;
+      }
+
+      const bool last = (i + 1 == n);
+      if (last && !open_last)
+      {
+        break;
+      }
+
+      Element *sub = w->submenu();
+      if (!sub || (levels.size() >= menu_stack.max_depth()))
+      {
+        return false;
+      }
+      levels.push_back(sub);
+      canvas = static_cast<Canvas *>(sub);
+    }
+
+    if (top_menu())
+    {
+      top_menu()->handle_exit();
+    }
+    menu_stack.clear();
+
+    // The levels in between were never entered, so they get a full enter on the way
+    // back out
+    for (size_t i = 0; i < levels.size(); ++i)
+    {
+      if (i < n)
+      {
+        static_cast<Canvas *>(levels[i])->set_cursor(path[i]);
+      }
+      menu_stack.push(levels[i]);
+    }
+
+    top_menu()->handle_enter();
+    menu_stack.top_level()->sync_gen = MenuStack::sync_generation();
+    return true;
+  }
+
   bool EventRouter::handle_hardwired_interceptors(const MenuEvent &ev)
   {
     // Filter out and route explicit bindings (hardwired or temporary override)
@@ -259,4 +387,63 @@ namespace esp32_ui
     return false;
   }
 
+  EventRouter::RealtimeSlot *EventRouter::realtime_slot(MenuEvent::Source src, uint8_t idx)
+  {
+    if (idx >= MAX_REALTIME_INDEX)
+    {
+      return nullptr;
+    }
+    if (src == MenuEvent::Source::Gate)
+    {
+      return &realtime_gate[idx];
+    }
+    if (src == MenuEvent::Source::Toggle)
+    {
+      return &realtime_toggle[idx];
+    }
+    return nullptr;
+  }
+
+  bool EventRouter::dispatch_realtime(const MenuEvent &ev)
+  {
+    auto *slot = realtime_slot(ev.source, ev.index);
+    if (!slot)
+    {
+      return false;
+    }
+
+    slot->running.fetch_add(1);
+    MenuBase *target = slot->popup.load(std::memory_order_acquire) ? nullptr : slot->target.load();
+    if (!target)
+    {
+      slot->running.fetch_sub(1);
+      return false;
+    }
+
+    const uint32_t start = micros();
+    target->handle_event(ev);
+    const uint32_t elapsed = micros() - start;
+    slot->running.fetch_sub(1);
+
+    rt_count.fetch_add(1, std::memory_order_relaxed);
+    rt_last_us.store(elapsed, std::memory_order_relaxed);
+    uint32_t worst = rt_worst_us.load(std::memory_order_relaxed);
+    while ((elapsed > worst) && !rt_worst_us.compare_exchange_weak(worst, elapsed, std::memory_order_relaxed))
+    {
+    }
+    return true;
+  }
+
+  EventRouter::RealtimeStats EventRouter::realtime_stats() const
+  {
+    return RealtimeStats{rt_count.load(), rt_last_us.load(), rt_worst_us.load()};
+  }
+
+  void EventRouter::reset_realtime_stats()
+  {
+    rt_count = 0;
+    rt_last_us = 0;
+    rt_worst_us = 0;
+  }
+
 } // namespace esp32_ui
@@ -0,0 +1,199 @@
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <esp32_ui/event_trace.h>
+#include <esp32_ui/event_router.h>
+#include <esp32_ui/ui_manager.h>
+
+namespace esp32_ui
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  // EventTraceRecorder
+  ////////////////////////////////////////////////////////////////////////////////
+  EventTraceRecorder::EventTraceRecorder(size_t capacity_bytes)
+      : capacity(capacity_bytes < HEADER_SIZE ? HEADER_SIZE : capacity_bytes)
+  {
+    buf.reserve(capacity);
+    clear();
+  }
+
+  void EventTraceRecorder::clear()
+  {
+    std::lock_guard<std::mutex> lock(buf_mutex);
+    buf.clear();
+    buf.push_back('E');
+    buf.push_back('U');
+    buf.push_back('T');
+    buf.push_back(VERSION);
+    n_dropped = 0;
+  }
+
+  void EventTraceRecorder::start()
+  {
+    last_us = micros();
+    recording = true;
+  }
+
+  void EventTraceRecorder::record(const MenuEvent &ev, uint32_t now_us)
+  {
+    if (!recording)
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(buf_mutex);
+    if (buf.size() + MAX_RECORD_SIZE > capacity)
+    {
+      ++n_dropped;
+      return;
+    }
+
+    uint32_t delta = now_us - last_us;
+    last_us = now_us;
+    do
+    {
+      uint8_t b = delta & 0x7F;
+      delta >>= 7;
+      buf.push_back(delta ? (b | 0x80) : b);
+    } while (delta);
+
+    buf.push_back(static_cast<uint8_t>(ev.source));
+    buf.push_back(static_cast<uint8_t>(ev.type));
+    buf.push_back(ev.index);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  // EventTraceReader
+  ////////////////////////////////////////////////////////////////////////////////
+  EventTraceReader::EventTraceReader(const uint8_t *trace, size_t len)
+      : p(trace),
+        end(trace + len),
+        ok(false)
+  {
+    if (trace && (len >= EventTraceRecorder::HEADER_SIZE) && (trace[0] == 'E') && (trace[1] == 'U') && (trace[2] == 'T') && (trace[3] == EventTraceRecorder::VERSION))
+    {
+      p += EventTraceRecorder::HEADER_SIZE;
+      ok = true;
+    }
+  }
+
+  bool EventTraceReader::next(MenuEvent &ev, uint32_t &delta_us)
+  {
+    if (!ok)
+    {
+      return false;
+    }
+
+    uint32_t delta = 0;
+    uint8_t shift = 0;
+    while (true)
+    {
+      if ((p >= end) || (shift > 28))
+      {
+        return false;
+      }
+      const uint8_t b = *p++;
+      delta |= uint32_t(b & 0x7F) << shift;
+      shift += 7;
+      if (!(b & 0x80))
+      {
+        break;
+      }
+    }
+
+    if (end - p < 3)
+    {
+      return false;
+    }
+
+    ev = MenuEvent{static_cast<MenuEvent::Source>(p[0]), static_cast<MenuEvent::Type>(p[1]), p[2]};
+    p += 3;
+    delta_us = delta;
+    return true;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  // EventReplayer
+  ////////////////////////////////////////////////////////////////////////////////
+  size_t EventReplayer::replay(const uint8_t *trace, size_t len, Pace pace)
+  {
+    EventTraceReader reader(trace, len);
+    auto *router = EventRouter::instance();
+
+    MenuEvent ev;
+    uint32_t delta_us = 0;
+    uint32_t clock_us = 0;
+    size_t count = 0;
+    const TickType_t start = xTaskGetTickCount();
+    while (reader.next(ev, delta_us))
+    {
+      // Rebuild timestamps from the recorded gaps, so field acceleration replays the
+      // same way at any pace
+      clock_us += delta_us;
+      ev.timestamp_ms = 1 + clock_us / 1000;
+
+      if (pace == Pace::Original)
+      {
+        // Wait for the event's time since the start, not its own gap, so sub-ms gaps
+        // add up and time spent dispatching isn't added on top
+        const TickType_t target = pdMS_TO_TICKS(clock_us / 1000);
+        const TickType_t elapsed = xTaskGetTickCount() - start;
+        if (target > elapsed)
+        {
+          vTaskDelay(target - elapsed);
+        }
+      }
+
+      router->dispatch(ev);
+      if (UIManager::consume_sync_request())
+      {
+        router->dispatch({MenuEvent::Source::System, MenuEvent::Type::Sync, 0});
+      }
+      ++count;
+    }
+
+    return count;
+  }
+
+  uint32_t EventReplayer::framebuffer_checksum(Display *d)
+  {
+    auto *top = EventRouter::instance()->top_menu();
+    uint32_t hash = 2166136261u;
+    auto hash_buffer = [&]()
+    {
+      if (top)
+      {
+        top->handle_draw(d);
+      }
+
+      const uint8_t *buf = d->getBufferPtr();
+      const size_t n = size_t(d->getBufferTileWidth()) * 8 * d->getBufferTileHeight();
+      for (size_t i = 0; i < n; ++i)
+      {
+        hash = (hash ^ buf[i]) * 16777619u;
+      }
+    };
+
+    if constexpr (Display::page_buffered)
+    {
+      // Step through the pages by hand: firstPage()/nextPage() would also send
+      // each one to the panel
+      const uint8_t page_rows = d->getBufferTileHeight();
+      const uint8_t panel_rows = d->getHeight() / 8;
+      for (uint8_t row = 0; row < panel_rows; row += page_rows)
+      {
+        d->setBufferCurrTileRow(row);
+        d->clearBuffer();
+        hash_buffer();
+      }
+      d->setBufferCurrTileRow(0);
+    }
+    else
+    {
+      d->clearBuffer();
+      hash_buffer();
+    }
+    return hash;
+  }
+
+} // namespace esp32_ui
@@ -19,22 +19,23 @@ bool FieldBase::handle_nav_delta(const MenuEvent &ev)
   menuprintf("%s: FieldBase handle_nav_delta\n", label);
   if ((ev.type == MenuEvent::Type::NavLeft) || (ev.type == MenuEvent::Type::NavUp))
   {
-    apply_delta(-1);
+    apply_delta(accel.scale(-1, ev));
     return true;
   }
 
   if ((ev.type == MenuEvent::Type::NavRight) || (ev.type == MenuEvent::Type::NavDown))
   {
-    apply_delta(+1);
+    apply_delta(accel.scale(+1, ev));
     return true;
   }
 
   return false;
 }
 
-void FieldBase::apply_delta(int8_t delta)
+void FieldBase::apply_delta(delta_t delta)
 {
-  UIManager::request_sync();
+  // An uncommitted edit; commit() moves the sync generation if the value changes
+  UIManager::request_local_sync();
 }
 
 // ======================================================================================
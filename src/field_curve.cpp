@@ -0,0 +1,43 @@
+#include <esp32_ui/field_curve.h>
+
+// Compile-time accuracy checks for the curve builders
+
+namespace esp32_ui
+{
+  namespace
+  {
+    constexpr bool near(double a, double b, double tol) { return (a > b) ? (a - b <= tol) : (b - a <= tol); }
+
+    static_assert(near(curve_math::exp(0.0), 1.0, 1e-15), "exp(0)");
+    static_assert(near(curve_math::exp(1.0), 2.718281828459045, 1e-14), "exp(1)");
+    static_assert(near(curve_math::exp(-20.0), 2.061153622438558e-9, 1e-22), "exp(-20)");
+    static_assert(near(curve_math::exp(40.0), 2.3538526683702e17, 1e4), "exp(40)");
+    static_assert(near(curve_math::log(1.0), 0.0, 1e-15), "log(1)");
+    static_assert(near(curve_math::log(1000.0), 6.907755278982137, 1e-13), "log(1000)");
+    static_assert(near(curve_math::log(1e-6), -13.815510557964274, 1e-13), "log(1e-6)");
+
+    constexpr auto FREQ = make_exp_curve<uint16_t, 128>(20, 20000);
+    static_assert((FREQ[0] == 20) && (FREQ[127] == 20000), "exp curve hits both ends");
+    static_assert(FREQ[63] > 600 && FREQ[63] < 640, "exp curve midpoint is the geometric mean");
+
+    constexpr auto GAIN = make_db_curve<float, 61>(-60, 0);
+    static_assert(near(GAIN[60], 1.0, 1e-6) && near(GAIN[40], 0.1, 1e-6), "dB curve");
+
+    constexpr auto LIN = make_linear_curve<int16_t, 5>(-100, 100);
+    static_assert((LIN[0] == -100) && (LIN[2] == 0) && (LIN[4] == 100), "linear curve");
+
+    constexpr auto TAPER = make_log_curve<uint8_t, 11>(0, 255);
+    static_assert((TAPER[0] == 0) && (TAPER[10] == 255) && (TAPER[1] > 25), "log curve");
+
+    constexpr FieldCurve<uint16_t> FREQ_CURVE(FREQ, "Hz");
+    static_assert(FREQ_CURVE.ascending() && FieldCurve<float>(GAIN).ascending(), "builders produce ascending tables");
+    static_assert(FREQ_CURVE.index_of(0) == 0, "below the table");
+    static_assert(FREQ_CURVE.index_of(65535) == 127, "above the table");
+    static_assert(FREQ_CURVE.at(FREQ_CURVE.index_of(FREQ[90])) == FREQ[90], "exact values map back");
+    static_assert(FREQ_CURVE.index_of(FREQ[90] + 1) == 90, "in-between values snap to the nearest entry");
+
+    constexpr auto FALLING = make_linear_curve<int16_t, 5>(100, -100);
+    static_assert(!FieldCurve<int16_t>(FALLING).ascending(), "descending tables are caught");
+  } // namespace
+
+} // namespace esp32_ui
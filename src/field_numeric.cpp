@@ -0,0 +1,190 @@
+#include <esp32_ui/field_numeric.h>
+
+// Compile-time edge-case checks for NumericCore. Nothing here ends up in the binary;
+// if any of the arithmetic regresses, the library stops building.
+
+namespace esp32_ui
+{
+  namespace
+  {
+    // Reference model: plain int64_t arithmetic, only valid for types up to 32 bits
+    template <typename T>
+    constexpr T ref_sat(T v, delta_t d, T lo, T hi)
+    {
+      const int64_t r = int64_t(v) + d;
+      return T((r < int64_t(lo)) ? lo : ((r > int64_t(hi)) ? hi : r));
+    }
+
+    template <typename T>
+    constexpr T ref_wrap(T v, delta_t d, T lo, T hi)
+    {
+      const int64_t span = int64_t(hi) - int64_t(lo) + 1;
+      int64_t off = (int64_t(v) - int64_t(lo) + d) % span;
+      if (off < 0)
+      {
+        off += span;
+      }
+      return T(int64_t(lo) + off);
+    }
+
+    // Every value of an 8-bit type, against the reference, for a handful of ranges
+    template <typename T>
+    constexpr bool exhaustive_8bit()
+    {
+      using Core = NumericCore<T>;
+      using L = std::numeric_limits<T>;
+      constexpr T ranges[][2] = {{L::min(), L::max()}, {T(L::min() + 3), T(L::max() - 5)}, {T(7), T(9)}, {T(0), T(0)}};
+      constexpr delta_t deltas[] = {std::numeric_limits<delta_t>::min(), -300, -256, -255, -128, -2, -1, 0,
+                                    1, 2, 127, 255, 256, 300, std::numeric_limits<delta_t>::max()};
+
+      for (const auto &r : ranges)
+      {
+        for (int v = r[0]; v <= r[1]; ++v)
+        {
+          for (const delta_t d : deltas)
+          {
+            if (Core::add_sat(T(v), d, r[0], r[1]) != ref_sat<T>(T(v), d, r[0], r[1]))
+            {
+              return false;
+            }
+            if (Core::add_wrap(T(v), d, r[0], r[1]) != ref_wrap<T>(T(v), d, r[0], r[1]))
+            {
+              return false;
+            }
+          }
+        }
+      }
+      return true;
+    }
+
+    static_assert(exhaustive_8bit<int8_t>(), "int8_t arithmetic");
+    static_assert(exhaustive_8bit<uint8_t>(), "uint8_t arithmetic");
+
+    // Edge values of the full range: min, min + 1, -1 (or mid), 0, 1, max - 1, max
+    template <typename T>
+    constexpr bool full_range_edges()
+    {
+      using Core = NumericCore<T>;
+      using L = std::numeric_limits<T>;
+      constexpr T lo = L::min();
+      constexpr T hi = L::max();
+      constexpr T values[] = {lo, T(lo + 1), std::is_signed_v<T> ? T(-1) : T(hi / 2), T(0), T(1), T(hi - 1), hi};
+      constexpr delta_t D_MIN = std::numeric_limits<delta_t>::min();
+      constexpr delta_t D_MAX = std::numeric_limits<delta_t>::max();
+
+      for (const T v : values)
+      {
+        // Nothing ever leaves the range, and a zero delta is a no-op
+        for (const delta_t d : {D_MIN, delta_t(-1), delta_t(0), delta_t(1), D_MAX})
+        {
+          const T s = Core::add_sat(v, d, lo, hi);
+          if ((s < lo) || (s > hi) || ((d == 0) && (s != v)))
+          {
+            return false;
+          }
+          if ((d > 0) && (s < v))
+          {
+            return false;
+          }
+          if ((d < 0) && (s > v))
+          {
+            return false;
+          }
+        }
+      }
+
+      // Saturation at both ends
+      if ((Core::add_sat(hi, 1, lo, hi) != hi) || (Core::add_sat(hi, D_MAX, lo, hi) != hi))
+      {
+        return false;
+      }
+      if ((Core::add_sat(lo, -1, lo, hi) != lo) || (Core::add_sat(lo, D_MIN, lo, hi) != lo))
+      {
+        return false;
+      }
+      if ((Core::add_sat(T(hi - 1), D_MAX, lo, hi) != hi) || (Core::add_sat(T(lo + 1), D_MIN, lo, hi) != lo))
+      {
+        return false;
+      }
+
+      // Single steps wrap around the full range, bigger ones never do
+      if ((Core::step(hi, 1, lo, hi, true) != lo) || (Core::step(lo, -1, lo, hi, true) != hi))
+      {
+        return false;
+      }
+      if ((Core::step(hi, 2, lo, hi, true) != hi) || (Core::step(lo, -2, lo, hi, true) != lo))
+      {
+        return false;
+      }
+      if ((Core::step(hi, 1, lo, hi, false) != hi) || (Core::step(lo, -1, lo, hi, false) != lo))
+      {
+        return false;
+      }
+      if ((Core::add_wrap(hi, 2, lo, hi) != T(lo + 1)) || (Core::add_wrap(lo, -2, lo, hi) != T(hi - 1)))
+      {
+        return false;
+      }
+
+      // Raw round trip
+      for (const T v : values)
+      {
+        if (Core::from_raw(Core::to_raw(v)) != v)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    static_assert(full_range_edges<int16_t>(), "int16_t arithmetic");
+    static_assert(full_range_edges<uint16_t>(), "uint16_t arithmetic");
+    static_assert(full_range_edges<int32_t>(), "int32_t arithmetic");
+    static_assert(full_range_edges<uint32_t>(), "uint32_t arithmetic");
+    static_assert(full_range_edges<int64_t>(), "int64_t arithmetic");
+    static_assert(full_range_edges<uint64_t>(), "uint64_t arithmetic");
+
+    // A sample-position style field: 0 .. 2^32 - 1, stepped by more than int8_t allows
+    static_assert(NumericCore<uint32_t>::add_sat(4294967200u, 1000, 0u, 4294967295u) == 4294967295u, "uint32_t saturates at max");
+    static_assert(NumericCore<uint32_t>::add_sat(100u, -1000, 0u, 4294967295u) == 0u, "uint32_t saturates at 0");
+    static_assert(NumericCore<uint32_t>::add_sat(1u << 20, 1 << 24, 0u, 4294967295u) == (1u << 20) + (1u << 24), "uint32_t wide delta");
+    static_assert(NumericCore<uint32_t>::add_wrap(4294967295u, 1, 0u, 4294967295u) == 0u, "uint32_t wraps");
+    static_assert(NumericCore<uint32_t>::to_delta(4000000000u) == std::numeric_limits<delta_t>::max(), "uint32_t step saturates");
+    static_assert(NumericCore<int64_t>::to_delta(std::numeric_limits<int64_t>::min()) == -std::numeric_limits<delta_t>::max(), "to_delta is symmetric");
+    static_assert(NumericCore<int64_t>::add_wrap(-5, -10, -10, 10) == 6, "int64_t wraps in a sub-range");
+    static_assert(NumericCore<int64_t>::add_wrap(3, 100, -10, 10) == -2, "int64_t wraps more than once");
+
+    // Sub-ranges and out-of-range starting values
+    static_assert(NumericCore<int16_t>::add_sat(-20, 1, -10, 10) == -10, "out-of-range values are pulled in");
+    static_assert(NumericCore<int16_t>::step(10, 1, -10, 10, true) == -10, "single step wraps");
+    static_assert(NumericCore<int16_t>::step(9, 5, -10, 10, true) == 10, "big step saturates");
+
+    // Fixed point: deltas are LSBs, saturation happens on the raw value
+    using Q8 = Fixed<8>;
+    static_assert(Q8::from_double(1.5).raw == 384, "Fixed<8> encoding");
+    static_assert(Q8::from_double(-1.5).raw == -384, "Fixed<8> negative encoding");
+    static_assert(NumericCore<Q8>::add_sat(Q8::from_double(1.0), 128, Q8::from_double(0.0), Q8::from_double(4.0)) == Q8::from_double(1.5), "Fixed<8> step");
+    static_assert(NumericCore<Q8>::add_sat(Q8::from_raw(std::numeric_limits<int32_t>::max() - 1), 10, Q8::from_raw(0), Q8::from_raw(std::numeric_limits<int32_t>::max())) == Q8::from_raw(std::numeric_limits<int32_t>::max()), "Fixed<8> saturates");
+    static_assert(NumericCore<Q8>::to_delta(Q8::from_double(0.25)) == 64, "Fixed<8> step as delta");
+    static_assert(NumericCore<Q8>::type == Element::FieldDataType::Fixed, "Fixed<8> data type");
+
+    // float: deltas are thousandths
+    static_assert(NumericCore<float>::add_sat(0.5f, 250, 0.0f, 1.0f) == 0.75f, "float step");
+    static_assert(NumericCore<float>::add_sat(0.9f, 500, 0.0f, 1.0f) == 1.0f, "float saturates");
+    static_assert(NumericCore<float>::step(1.0f, 100, 0.0f, 1.0f, true) == 0.0f, "float wraps from the end");
+    static_assert(NumericCore<float>::step(0.95f, 100, 0.0f, 1.0f, true) == 1.0f, "float wraps only from the end");
+    static_assert(NumericCore<float>::to_delta(0.01f) == 10, "float step as delta");
+    static_assert(NumericCore<float>::to_delta(-1e12f) == -std::numeric_limits<delta_t>::max(), "float step saturates");
+
+    // FieldDataType coverage
+    static_assert(field_data_type_of<int8_t>() == Element::FieldDataType::Int8, "Int8");
+    static_assert(field_data_type_of<uint8_t>() == Element::FieldDataType::UInt8, "UInt8");
+    static_assert(field_data_type_of<int16_t>() == Element::FieldDataType::Int16, "Int16");
+    static_assert(field_data_type_of<uint16_t>() == Element::FieldDataType::UInt16, "UInt16");
+    static_assert(field_data_type_of<int32_t>() == Element::FieldDataType::Int32, "Int32");
+    static_assert(field_data_type_of<uint32_t>() == Element::FieldDataType::UInt32, "UInt32");
+    static_assert(field_data_type_of<int64_t>() == Element::FieldDataType::Int64, "Int64");
+    static_assert(field_data_type_of<float>() == Element::FieldDataType::Float, "Float");
+    static_assert(!NumericCore<bool>::supported, "bool is not a numeric field type");
+  } // namespace
+
+} // namespace esp32_ui
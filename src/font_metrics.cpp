@@ -0,0 +1,195 @@
+#include <string.h>
+#include <esp32_ui/font_metrics.h>
+
+namespace esp32_ui
+{
+  uint8_t Display::char_width() const
+  {
+    // Only reads the current font, but U8g2's accessors aren't const
+    return FontMetrics::instance()->max_advance(const_cast<Display *>(this));
+  }
+
+  FontMetrics *FontMetrics::instance()
+  {
+    static FontMetrics inst;
+    return &inst;
+  }
+
+  void FontMetrics::build(GlyphTable &t, Display *d)
+  {
+    t.font = d->current_font();
+    t.widest = 0;
+    for (size_t i = 0; i < NUM_GLYPHS; ++i)
+    {
+      const int8_t adv = d->glyph_advance(FIRST_GLYPH + i);
+      t.advance[i] = (adv > 0) ? adv : 0;
+      if (t.advance[i] > t.widest)
+      {
+        t.widest = t.advance[i];
+      }
+    }
+  }
+
+  const FontMetrics::GlyphTable &FontMetrics::table(Display *d)
+  {
+    const uint8_t *font = d->current_font();
+    if (!font)
+    {
+      if (!fallback.widest)
+      {
+        memset(fallback.advance, FALLBACK_ADVANCE, sizeof(fallback.advance));
+        fallback.widest = FALLBACK_ADVANCE;
+      }
+      return fallback;
+    }
+
+    // Nearly always the same font as last time
+    if (tables[last_used].font == font)
+    {
+      return tables[last_used];
+    }
+
+    for (uint8_t i = 0; i < MAX_FONTS; ++i)
+    {
+      if (tables[i].font == font)
+      {
+        last_used = i;
+        return tables[i];
+      }
+    }
+
+    last_used = next_slot;
+    next_slot = (next_slot + 1) % MAX_FONTS;
+    build(tables[last_used], d);
+    return tables[last_used];
+  }
+
+  uint8_t FontMetrics::lookup(const GlyphTable &t, char c)
+  {
+    const uint8_t u = static_cast<uint8_t>(c);
+    if ((u < FIRST_GLYPH) || (u > LAST_GLYPH))
+    {
+      return t.widest;
+    }
+    return t.advance[u - FIRST_GLYPH];
+  }
+
+  uint8_t FontMetrics::advance(Display *d, char c)
+  {
+    return lookup(table(d), c);
+  }
+
+  uint8_t FontMetrics::max_advance(Display *d)
+  {
+    return table(d).widest;
+  }
+
+  uint16_t FontMetrics::text_width(Display *d, const char *s, size_t max_len)
+  {
+    if (!s)
+    {
+      return 0;
+    }
+
+    const GlyphTable &t = table(d);
+    uint16_t w = 0;
+    for (size_t i = 0; (i < max_len) && s[i]; ++i)
+    {
+      w += lookup(t, s[i]);
+    }
+    return w;
+  }
+
+  size_t FontMetrics::fit(Display *d, const char *s, uint16_t max_w)
+  {
+    if (!s)
+    {
+      return 0;
+    }
+
+    const GlyphTable &t = table(d);
+    uint16_t w = 0;
+    size_t n = 0;
+    for (; s[n]; ++n)
+    {
+      w += lookup(t, s[n]);
+      if (w > max_w)
+      {
+        break;
+      }
+    }
+    return n;
+  }
+
+  size_t FontMetrics::truncate(Display *d, const char *s, uint16_t max_w, char *out, size_t out_size)
+  {
+    if (!out || !out_size)
+    {
+      return 0;
+    }
+
+    size_t n = fit(d, s, max_w);
+    if (n > out_size - 1)
+    {
+      n = out_size - 1;
+    }
+    if (n)
+    {
+      memcpy(out, s, n);
+    }
+    out[n] = '\0';
+    return n;
+  }
+
+  size_t FontMetrics::ellipsize(Display *d, const char *s, uint16_t max_w, char *out, size_t out_size)
+  {
+    if (!out || !out_size)
+    {
+      return 0;
+    }
+
+    const size_t len = s ? strlen(s) : 0;
+    if ((fit(d, s, max_w) == len) && (len < out_size))
+    {
+      return truncate(d, s, max_w, out, out_size);
+    }
+
+    // Doesn't fit: keep the longest prefix that leaves room for the ellipsis
+    const uint16_t ell_w = text_width(d, ELLIPSIS);
+    const size_t ell_len = strlen(ELLIPSIS);
+    if ((ell_w > max_w) || (out_size <= ell_len))
+    {
+      return truncate(d, s, max_w, out, out_size);
+    }
+
+    size_t n = fit(d, s, max_w - ell_w);
+    if (n > out_size - 1 - ell_len)
+    {
+      n = out_size - 1 - ell_len;
+    }
+    memcpy(out, s, n);
+    memcpy(out + n, ELLIPSIS, ell_len + 1);
+    return n + ell_len;
+  }
+
+  uint16_t FontMetrics::align_x(Display *d, const char *s, uint16_t x, uint16_t w, Align align)
+  {
+    const uint16_t text_w = text_width(d, s);
+    if ((align == Align::Left) || (text_w >= w))
+    {
+      return x;
+    }
+    return (align == Align::Right) ? (x + w - text_w) : (x + (w - text_w) / 2);
+  }
+
+  void FontMetrics::clear()
+  {
+    for (auto &t : tables)
+    {
+      t.font = nullptr;
+    }
+    last_used = 0;
+    next_slot = 0;
+  }
+
+} // namespace esp32_ui
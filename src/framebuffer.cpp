@@ -0,0 +1,176 @@
+#include <string.h>
+#include <esp32_ui/framebuffer.h>
+
+namespace esp32_ui
+{
+  namespace
+  {
+    template <FrameBuffer::RasterOp OP>
+    inline uint32_t raster(uint32_t v, uint32_t m)
+    {
+      if constexpr (OP == FrameBuffer::RasterOp::Set)
+      {
+        return v | m;
+      }
+      else if constexpr (OP == FrameBuffer::RasterOp::Clear)
+      {
+        return v & ~m;
+      }
+      else
+      {
+        return v ^ m;
+      }
+    }
+
+    // Apply `mask` to n consecutive bytes: single bytes up to a word boundary, then
+    // whole words, then the leftovers. memcpy keeps the word accesses legal on a
+    // uint8_t buffer and compiles down to plain 32-bit loads/stores.
+    template <FrameBuffer::RasterOp OP>
+    void raster_span(uint8_t *p, size_t n, uint8_t mask)
+    {
+      while (n && (reinterpret_cast<uintptr_t>(p) & 3))
+      {
+        *p = raster<OP>(*p, mask);
+        ++p;
+        --n;
+      }
+
+      const uint32_t mask32 = mask * 0x01010101u;
+      while (n >= 4)
+      {
+        uint32_t v;
+        memcpy(&v, p, 4);
+        v = raster<OP>(v, mask32);
+        memcpy(p, &v, 4);
+        p += 4;
+        n -= 4;
+      }
+
+      while (n--)
+      {
+        *p = raster<OP>(*p, mask);
+        ++p;
+      }
+    }
+
+    template <FrameBuffer::RasterOp OP>
+    void raster_rect(uint8_t *buf, uint16_t stride, uint16_t x, uint16_t y0, uint16_t w, uint16_t y1)
+    {
+      for (uint16_t tile_row = y0 >> 3; (tile_row << 3) < y1; ++tile_row)
+      {
+        const uint16_t top = tile_row << 3;
+        const uint8_t first_bit = (y0 > top) ? (y0 - top) : 0;
+        const uint8_t end_bit = (y1 < top + 8) ? (y1 - top) : 8;
+        const uint8_t mask = uint8_t((0xFFu << first_bit) & (0xFFu >> (8 - end_bit)));
+        raster_span<OP>(buf + size_t(tile_row) * stride + x, w, mask);
+      }
+    }
+  } // namespace
+
+  void FrameBuffer::apply(RasterOp op, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+  {
+    // Panel rows to buffer rows
+    if (y < top)
+    {
+      if (h <= top - y)
+      {
+        return;
+      }
+      h -= top - y;
+      y = 0;
+    }
+    else
+    {
+      y -= top;
+    }
+
+    if (!buf || (x >= width()) || (y >= height()) || !w || !h)
+    {
+      return;
+    }
+
+    if (w > width() - x)
+    {
+      w = width() - x;
+    }
+
+    const uint16_t y1 = (h > height() - y) ? height() : (y + h);
+
+    switch (op)
+    {
+    case RasterOp::Set:
+      raster_rect<RasterOp::Set>(buf, stride, x, y, w, y1);
+      break;
+    case RasterOp::Clear:
+      raster_rect<RasterOp::Clear>(buf, stride, x, y, w, y1);
+      break;
+    case RasterOp::Xor:
+      raster_rect<RasterOp::Xor>(buf, stride, x, y, w, y1);
+      break;
+    }
+  }
+
+  void FrameBuffer::xor_overlay(const uint8_t *src)
+  {
+    if (!buf || !src)
+    {
+      return;
+    }
+
+    uint8_t *p = buf;
+    size_t n = size();
+    while (n >= 4)
+    {
+      uint32_t a, b;
+      memcpy(&a, p, 4);
+      memcpy(&b, src, 4);
+      a ^= b;
+      memcpy(p, &a, 4);
+      p += 4;
+      src += 4;
+      n -= 4;
+    }
+
+    while (n--)
+    {
+      *p++ ^= *src++;
+    }
+  }
+
+  void FrameBuffer::scroll_up(uint8_t rows)
+  {
+    if (!buf)
+    {
+      return;
+    }
+
+    if (rows >= tile_rows)
+    {
+      memset(buf, 0, size());
+      return;
+    }
+
+    const size_t shift = size_t(rows) * stride;
+    memmove(buf, buf + shift, size() - shift);
+    memset(buf + size() - shift, 0, shift);
+  }
+
+  void FrameBuffer::scroll_down(uint8_t rows)
+  {
+    if (!buf)
+    {
+      return;
+    }
+
+    if (rows >= tile_rows)
+    {
+      memset(buf, 0, size());
+      return;
+    }
+
+    const size_t shift = size_t(rows) * stride;
+    memmove(buf + shift, buf, size() - shift);
+    memset(buf, 0, shift);
+  }
+
+} // namespace esp32_ui
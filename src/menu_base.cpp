@@ -1,4 +1,5 @@
 #include <esp32_ui/menu_base.h>
+#include <esp32_ui/span_trace.h>
 
 namespace esp32_ui
 {
@@ -19,6 +20,7 @@ namespace esp32_ui
 
   bool MenuBase::handle_event(const MenuEvent &ev)
   {
+    UI_SPAN("MenuBase::handle_event", label);
     if (ev.type == MenuEvent::Type::Sync)
     {
       handle_sync();
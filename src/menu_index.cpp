@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <string.h>
+#include <esp32_ui/menu_index.h>
+#include <esp32_ui/event_router.h>
+
+namespace esp32_ui
+{
+  namespace
+  {
+    inline char lower(char c)
+    {
+      return ((c >= 'A') && (c <= 'Z')) ? char(c - 'A' + 'a') : c;
+    }
+
+    // strcmp, ignoring ASCII case; with n, compares at most n characters
+    int compare(const char *a, const char *b, size_t n = SIZE_MAX)
+    {
+      for (size_t i = 0; i < n; ++i)
+      {
+        const char ca = lower(a[i]);
+        const char cb = lower(b[i]);
+        if (ca != cb)
+        {
+          return (uint8_t(ca) < uint8_t(cb)) ? -1 : 1;
+        }
+        if (!ca)
+        {
+          break;
+        }
+      }
+      return 0;
+    }
+  } // namespace
+
+  void MenuIndex::clear()
+  {
+    entries.clear();
+    paths.clear();
+  }
+
+  void MenuIndex::add(const char *label, const uint8_t *path, uint8_t len, Kind kind)
+  {
+    if (!label || !*label)
+    {
+      return;
+    }
+    entries.push_back(Entry{label, uint16_t(paths.size()), len, kind});
+    paths.insert(paths.end(), path, path + len);
+  }
+
+  void MenuIndex::walk(Canvas *canvas, uint8_t *path, uint8_t depth)
+  {
+    const size_t n = std::min<size_t>(canvas->num_widgets(), UINT8_MAX + 1);
+    for (size_t i = 0; i < n; ++i)
+    {
+      Widget *w = canvas->widget_at(i);
+      if (!w)
+      {
+        continue;
+      }
+
+      path[depth] = uint8_t(i);
+      Element *sub = w->submenu();
+      if (!sub)
+      {
+        add(w->label, path, depth + 1, Kind::Widget);
+        continue;
+      }
+
+      // A submenu's Widget shares the Canvas label, so only the Canvas is indexed.
+      // Anything the stack can't hold isn't reachable by jump_to() either.
+      if (size_t(depth) + 2 > max_depth)
+      {
+        continue;
+      }
+      add(sub->label, path, depth + 1, Kind::Canvas);
+      walk(static_cast<Canvas *>(sub), path, depth + 1);
+    }
+  }
+
+  size_t MenuIndex::build(Canvas *root)
+  {
+    clear();
+    if (!root)
+    {
+      return 0;
+    }
+
+    max_depth = EventRouter::instance()->max_menu_depth();
+    std::vector<uint8_t> path(max_depth);
+    add(root->label, path.data(), 0, Kind::Canvas);
+    walk(root, path.data(), 0);
+
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+                     { return compare(a.label, b.label) < 0; });
+    entries.shrink_to_fit();
+    paths.shrink_to_fit();
+    return entries.size();
+  }
+
+  MenuIndex::Range MenuIndex::find_prefix(const char *prefix) const
+  {
+    const Entry *first = entries.data();
+    const Entry *last = first + entries.size();
+    if (!prefix)
+    {
+      return Range{last, last};
+    }
+
+    const size_t len = strlen(prefix);
+    auto lo = std::lower_bound(first, last, prefix, [len](const Entry &e, const char *p)
+                               { return compare(e.label, p, len) < 0; });
+    auto hi = std::upper_bound(lo, last, prefix, [len](const char *p, const Entry &e)
+                               { return compare(p, e.label, len) < 0; });
+    return Range{lo, hi};
+  }
+
+  const MenuIndex::Entry *MenuIndex::find(const char *label) const
+  {
+    const Entry *first = entries.data();
+    const Entry *last = first + entries.size();
+    if (!label)
+    {
+      return nullptr;
+    }
+
+    auto it = std::lower_bound(first, last, label, [](const Entry &e, const char *l)
+                               { return compare(e.label, l) < 0; });
+    return ((it != last) && !compare(it->label, label)) ? it : nullptr;
+  }
+
+  bool MenuIndex::jump(const Entry &e) const
+  {
+    // A Canvas entry's last step is the Widget that links to it
+    return EventRouter::instance()->jump_to(path(e), e.path_len, (e.kind == Kind::Canvas) && e.path_len);
+  }
+
+} // namespace esp32_ui
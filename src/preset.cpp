@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <string.h>
+#include <esp32_ui/preset.h>
+#include <esp32_ui/commit_batch.h>
+#include <esp32_ui/edit_journal.h>
+#include <esp32_ui/ui_manager.h>
+
+namespace esp32_ui
+{
+  namespace
+  {
+    bool is_signed(Element::FieldDataType type)
+    {
+      return (type == Element::FieldDataType::Int8) ||
+             (type == Element::FieldDataType::Int16) ||
+             (type == Element::FieldDataType::Int32) ||
+             (type == Element::FieldDataType::Int64) ||
+             (type == Element::FieldDataType::Fixed);
+    }
+
+    void put(std::vector<uint8_t> &out, uint64_t v, uint8_t n)
+    {
+      for (uint8_t i = 0; i < n; ++i)
+      {
+        out.push_back(uint8_t(v >> (8 * i)));
+      }
+    }
+
+    uint64_t get(const uint8_t *p, uint8_t n)
+    {
+      uint64_t v = 0;
+      for (uint8_t i = 0; i < n; ++i)
+      {
+        v |= uint64_t(p[i]) << (8 * i);
+      }
+      return v;
+    }
+
+    int64_t to_raw(uint64_t v, uint8_t n, bool sign_extend)
+    {
+      if ((n < 8) && sign_extend && (v & (uint64_t(1) << (8 * n - 1))))
+      {
+        v |= ~uint64_t(0) << (8 * n);
+      }
+      return int64_t(v);
+    }
+  } // namespace
+
+  bool Preset::add(FieldBase *field)
+  {
+    if (!field || !field->get_field_id())
+    {
+      return false;
+    }
+
+    auto it = std::lower_bound(fields.begin(), fields.end(), field->get_field_id(), [](const FieldBase *f, uint16_t id)
+                               { return f->get_field_id() < id; });
+    if ((it != fields.end()) && ((*it)->get_field_id() == field->get_field_id()))
+    {
+      menuprintf("Preset: field id %u used twice, ignoring %s\n", field->get_field_id(), field->label);
+      return false;
+    }
+    fields.insert(it, field);
+    return true;
+  }
+
+  void Preset::walk(Element *node)
+  {
+    if (!node)
+    {
+      return;
+    }
+
+    switch (node->base_type())
+    {
+    case BaseType::Field:
+      add(static_cast<FieldBase *>(node));
+      break;
+    case BaseType::Widget:
+    case BaseType::WidgetPair:
+    {
+      const Widget *w = static_cast<Widget *>(node);
+      for (size_t i = 0; i < w->num_elements(); ++i)
+      {
+        walk(w->element_at(i));
+      }
+      walk(w->submenu());
+      break;
+    }
+    case BaseType::Canvas:
+    {
+      const Canvas *c = static_cast<Canvas *>(node);
+      for (size_t i = 0; i < c->num_widgets(); ++i)
+      {
+        walk(c->widget_at(i));
+      }
+      break;
+    }
+    default:
+      break;
+    }
+  }
+
+  size_t Preset::build(Canvas *root)
+  {
+    clear();
+    walk(root);
+    fields.shrink_to_fit();
+    return fields.size();
+  }
+
+  FieldBase *Preset::find(uint16_t id) const
+  {
+    auto it = std::lower_bound(fields.begin(), fields.end(), id, [](const FieldBase *f, uint16_t id)
+                               { return f->get_field_id() < id; });
+    return ((it != fields.end()) && ((*it)->get_field_id() == id)) ? *it : nullptr;
+  }
+
+  size_t Preset::save(std::vector<uint8_t> &out) const
+  {
+    out.clear();
+    out.reserve(HEADER_SIZE + fields.size() * (ENTRY_HEADER_SIZE + 4));
+    out.insert(out.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    out.push_back(VERSION);
+    out.push_back(0);
+    put(out, 0, 2); // count, filled in below
+
+    uint16_t count = 0;
+    for (FieldBase *f : fields)
+    {
+      const uint8_t n = f->raw_size();
+      int64_t raw = 0;
+      if (!n || (n > 8) || !f->committed_raw(raw))
+      {
+        continue;
+      }
+
+      put(out, f->get_field_id(), 2);
+      out.push_back(uint8_t(f->field_data_type()));
+      out.push_back(n);
+      out.push_back(f->raw_frac_bits());
+      put(out, uint64_t(raw), n);
+      ++count;
+    }
+
+    out[6] = uint8_t(count);
+    out[7] = uint8_t(count >> 8);
+    return out.size();
+  }
+
+  template <typename Fn>
+  bool Preset::for_each_change(const uint8_t *data, size_t len, Fn fn) const
+  {
+    if (!data || (len < HEADER_SIZE) || memcmp(data, MAGIC, sizeof(MAGIC)) || (data[4] != VERSION))
+    {
+      return false;
+    }
+
+    const uint16_t count = uint16_t(get(data + 6, 2));
+    const uint8_t *p = data + HEADER_SIZE;
+    const uint8_t *end = data + len;
+    for (uint16_t i = 0; i < count; ++i)
+    {
+      if (size_t(end - p) < ENTRY_HEADER_SIZE)
+      {
+        return false;
+      }
+      const uint16_t id = uint16_t(get(p, 2));
+      const auto type = static_cast<Element::FieldDataType>(p[2]);
+      const uint8_t n = p[3];
+      const uint8_t frac_bits = p[4];
+      p += ENTRY_HEADER_SIZE;
+      if ((n > 8) || (size_t(end - p) < n))
+      {
+        return false;
+      }
+      const uint64_t bits = get(p, n);
+      p += n;
+
+      // Gone, or no longer the same kind of value
+      FieldBase *f = find(id);
+      if (!f || (f->field_data_type() != type) || (f->raw_size() != n) || (f->raw_frac_bits() != frac_bits))
+      {
+        continue;
+      }
+
+      const int64_t raw = to_raw(bits, n, is_signed(type));
+      int64_t current = 0;
+      if (f->committed_raw(current) && (current != raw))
+      {
+        fn(f, raw);
+      }
+    }
+    return true;
+  }
+
+  size_t Preset::diff(const uint8_t *data, size_t len) const
+  {
+    size_t n = 0;
+    if (!for_each_change(data, len, [&n](FieldBase *, int64_t)
+                         { ++n; }))
+    {
+      return 0;
+    }
+    return n;
+  }
+
+  bool Preset::load(const uint8_t *data, size_t len, size_t *changed)
+  {
+    // Check the whole blob before touching anything
+    std::vector<Item> items;
+    items.reserve(fields.size());
+    if (!for_each_change(data, len, [&items](FieldBase *f, int64_t raw)
+                         { items.push_back(Item{f, raw}); }))
+    {
+      return false;
+    }
+
+    if (!items.empty())
+    {
+      EditJournal::Pause pause;
+      CommitTransaction txn;
+      for (const Item &item : items)
+      {
+        item.field->restore_raw(item.raw);
+      }
+    }
+
+    if (changed)
+    {
+      *changed = items.size();
+    }
+    if (!items.empty())
+    {
+      UIManager::schedule_redraw();
+    }
+    return true;
+  }
+
+} // namespace esp32_ui
@@ -0,0 +1,44 @@
+#include <esp32_ui/scope_widget.h>
+
+namespace esp32_ui
+{
+  void ScopeWidget::handle_draw(Display *d) const
+  {
+    if ((height < 2) || (range_hi <= range_lo))
+    {
+      return;
+    }
+
+    const uint8_t y0 = d->getCursorY();
+    size_t width = d->getWidth();
+    if (width > MAX_COLUMNS)
+    {
+      width = MAX_COLUMNS;
+    }
+
+    // One snapshot per frame: pages further down reuse the first page's, so the
+    // producer can't shift the trace between pages
+    if (!Display::page_buffered || d->rows_in_buffer(y0, 1))
+    {
+      scratch_len = ring.snapshot(scratch, width);
+    }
+    const size_t n = scratch_len;
+
+    // Newest column sits at the right edge
+    const int32_t span = int32_t(range_hi) - range_lo;
+    const int32_t rows = height - 1;
+    uint8_t x = width - n;
+    for (size_t i = 0; i < n; ++i, ++x)
+    {
+      int32_t lo = scratch[i].lo;
+      int32_t hi = scratch[i].hi;
+      lo = (lo < range_lo) ? range_lo : ((lo > range_hi) ? range_hi : lo);
+      hi = (hi < range_lo) ? range_lo : ((hi > range_hi) ? range_hi : hi);
+
+      const uint8_t y_top = y0 + rows - ((hi - range_lo) * rows) / span;
+      const uint8_t y_bot = y0 + rows - ((lo - range_lo) * rows) / span;
+      d->drawVLine(x, y_top, y_bot - y_top + 1);
+    }
+  }
+
+} // namespace esp32_ui
@@ -0,0 +1,301 @@
+#include <Arduino.h>
+#include <esp32_ui/screen_saver.h>
+#include <esp32_ui/framebuffer.h>
+
+namespace esp32_ui
+{
+  namespace
+  {
+    // round(127 * sin(2 * pi * i / 64))
+    const int8_t SINE_64[64] = {
+        0, 12, 25, 37, 49, 60, 71, 81, 90, 98, 106, 112, 117, 122, 125, 126,
+        127, 126, 125, 122, 117, 112, 106, 98, 90, 81, 71, 60, 49, 37, 25, 12,
+        0, -12, -25, -37, -49, -60, -71, -81, -90, -98, -106, -112, -117, -122, -125, -126,
+        -127, -126, -125, -122, -117, -112, -106, -98, -90, -81, -71, -60, -49, -37, -25, -12};
+
+    // 4x4 ordered-dither thresholds spread over the plasma's -381..381 range
+    const int16_t BAYER_4X4[4][4] = {
+        {-360, 24, -264, 120},
+        {216, -168, 312, -72},
+        {-216, 168, -312, 72},
+        {360, -24, 264, -120}};
+
+    // U8g2 full-buffer layout: one byte per column per 8-pixel tile row, LSB on top
+    inline void set_pixel(uint8_t *buf, uint16_t stride, uint8_t x, uint8_t y)
+    {
+      buf[(y >> 3) * stride + x] |= (1 << (y & 7));
+    }
+
+    inline uint32_t next_random(uint32_t &seed)
+    {
+      seed = seed * 1664525u + 1013904223u;
+      return seed;
+    }
+  } // namespace
+
+  ////////////////////////////////////////////////////////////////////////////////
+  // Starfield
+  ////////////////////////////////////////////////////////////////////////////////
+  void Starfield::respawn(Star &s)
+  {
+    const uint32_t r = next_random(seed);
+    s.x = static_cast<int8_t>(r >> 24);
+    s.y = static_cast<int8_t>(r >> 16);
+    s.z = 0xFF00;
+  }
+
+  void Starfield::reset()
+  {
+    for (auto &s : stars)
+    {
+      respawn(s);
+      s.z = (next_random(seed) >> 16) | 0x0800;
+    }
+  }
+
+  void Starfield::render(Display *d, uint32_t frame, uint8_t coarseness)
+  {
+    uint8_t *buf = d->getBufferPtr();
+    const uint16_t stride = d->getBufferTileWidth() * 8;
+    const int16_t w = d->getWidth();
+    const int16_t h = d->getHeight();
+    const uint16_t dz = uint16_t(speed) << 6;
+    const uint8_t stride_stars = 1 << coarseness;
+
+    for (uint8_t i = 0; i < NUM_STARS; i += stride_stars)
+    {
+      Star &s = stars[i];
+      if (s.z <= dz)
+      {
+        respawn(s);
+        continue;
+      }
+      s.z -= dz;
+
+      const int16_t sx = (w >> 1) + ((int32_t(s.x) << 13) / s.z);
+      const int16_t sy = (h >> 1) + ((int32_t(s.y) << 12) / s.z);
+      if ((sx < 0) || (sx >= w) || (sy < 0) || (sy >= h))
+      {
+        respawn(s);
+        continue;
+      }
+
+      set_pixel(buf, stride, sx, sy);
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  // Plasma
+  ////////////////////////////////////////////////////////////////////////////////
+  void Plasma::render(Display *d, uint32_t frame, uint8_t coarseness)
+  {
+    const uint8_t w = d->getWidth();
+    const uint8_t h = d->getHeight();
+    const uint8_t t = frame;
+
+    if (coarseness == 0)
+    {
+      uint8_t *buf = d->getBufferPtr();
+      const uint16_t stride = d->getBufferTileWidth() * 8;
+      for (uint8_t y = 0; y < h; ++y)
+      {
+        const int16_t row = SINE_64[((y << 1) + (t >> 1)) & 63];
+        for (uint8_t x = 0; x < w; ++x)
+        {
+          const int16_t v = row + SINE_64[(x + t) & 63] + SINE_64[((x + y + (t << 1)) >> 1) & 63];
+          if (v > BAYER_4X4[y & 3][x & 3])
+          {
+            set_pixel(buf, stride, x, y);
+          }
+        }
+      }
+      return;
+    }
+
+    // Coarse: dither per block instead of per pixel, and fill each run of lit blocks
+    // with one word-wide FrameBuffer op
+    FrameBuffer fb(d);
+    const uint8_t block = 1 << coarseness;
+    for (uint8_t y = 0, by = 0; y < h; y += block, ++by)
+    {
+      const int16_t row = SINE_64[((y << 1) + (t >> 1)) & 63];
+      uint8_t run = 0;
+      uint8_t run_x = 0;
+      for (uint8_t x = 0, bx = 0; x < w; x += block, ++bx)
+      {
+        const int16_t v = row + SINE_64[(x + t) & 63] + SINE_64[((x + y + (t << 1)) >> 1) & 63];
+        if (v > BAYER_4X4[by & 3][bx & 3])
+        {
+          if (!run)
+          {
+            run_x = x;
+          }
+          run += block;
+        }
+        else if (run)
+        {
+          fb.fill_rect(run_x, y, run, block);
+          run = 0;
+        }
+      }
+      if (run)
+      {
+        fb.fill_rect(run_x, y, run, block);
+      }
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  // ScrollingText
+  ////////////////////////////////////////////////////////////////////////////////
+  void ScrollingText::render(Display *d, uint32_t frame, uint8_t coarseness)
+  {
+    if (text_width < 0)
+    {
+      text_width = d->getStrWidth(text);
+    }
+
+    if ((x == INT16_MAX) || (x < -text_width))
+    {
+      x = d->getWidth();
+    }
+
+    d->drawStr(x, (d->getHeight() - d->getMaxCharHeight()) / 2, text);
+    x -= px_per_frame;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  // ScreenSaverEngine
+  ////////////////////////////////////////////////////////////////////////////////
+  void ScreenSaverEngine::add_effect(std::unique_ptr<ScreenSaverEffect> effect)
+  {
+    effects.push_back(std::move(effect));
+  }
+
+  void ScreenSaverEngine::next_effect()
+  {
+    if (effects.empty())
+    {
+      return;
+    }
+
+    current = (current + 1) % effects.size();
+    start();
+  }
+
+  void ScreenSaverEngine::set_dormant(bool on_off)
+  {
+    forced_dormant = on_off;
+    dormant = on_off;
+    dormant_frame_sent = false;
+  }
+
+  void ScreenSaverEngine::start()
+  {
+    running = true;
+    dormant = forced_dormant;
+    dormant_frame_sent = false;
+    frame = 0;
+    coarseness = 0;
+    frame_skip = 0;
+    skip_count = 0;
+    over_streak = 0;
+    under_streak = 0;
+    effects[current]->reset();
+  }
+
+  bool ScreenSaverEngine::tick(Display *d)
+  {
+    if (effects.empty())
+    {
+      return false;
+    }
+
+    if (!running)
+    {
+      start();
+    }
+
+    if (dormant)
+    {
+      if (dormant_frame_sent)
+      {
+        return false;
+      }
+      d->clearBuffer();
+      dormant_frame_sent = true;
+      return true;
+    }
+
+    if (skip_count < frame_skip)
+    {
+      ++skip_count;
+      return false;
+    }
+    skip_count = 0;
+
+    auto &effect = *effects[current];
+    const uint32_t t0 = micros();
+    d->clearBuffer();
+    effect.render(d, frame++, coarseness);
+    last_cost_us = micros() - t0;
+
+    const uint32_t budget = effect.budget_us();
+    if (last_cost_us > budget)
+    {
+      under_streak = 0;
+      if (++over_streak >= OVERRUN_STREAK)
+      {
+        over_streak = 0;
+        degrade(effect);
+      }
+    }
+    else if (last_cost_us < (budget >> 1))
+    {
+      over_streak = 0;
+      if (++under_streak >= RECOVER_STREAK)
+      {
+        under_streak = 0;
+        recover();
+      }
+    }
+    else
+    {
+      over_streak = 0;
+      under_streak = 0;
+    }
+
+    return true;
+  }
+
+  // Cheapest way out first: resolution, then frame rate, then give up
+  void ScreenSaverEngine::degrade(const ScreenSaverEffect &effect)
+  {
+    if (coarseness < effect.max_coarseness())
+    {
+      ++coarseness;
+    }
+    else if (frame_skip < MAX_FRAME_SKIP)
+    {
+      frame_skip = (frame_skip << 1) | 1;
+    }
+    else
+    {
+      dormant = true;
+      dormant_frame_sent = false;
+    }
+  }
+
+  void ScreenSaverEngine::recover()
+  {
+    if (frame_skip)
+    {
+      frame_skip >>= 1;
+    }
+    else if (coarseness)
+    {
+      --coarseness;
+    }
+  }
+
+} // namespace esp32_ui
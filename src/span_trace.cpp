@@ -0,0 +1,148 @@
+#include <esp32_ui/span_trace.h>
+
+#ifdef ESP32_UI_SPAN_TRACE
+
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace esp32_ui
+{
+  namespace
+  {
+    struct SpanRecord
+    {
+      const char *name;
+      const char *label;
+      uint32_t ts_us;
+      bool begin;
+    };
+
+    struct TaskRing
+    {
+      std::atomic<TaskHandle_t> task{nullptr};
+      uint32_t head = 0;
+      SpanRecord records[ESP32_UI_SPAN_EVENTS];
+    };
+
+    TaskRing rings[ESP32_UI_SPAN_TASKS];
+
+    // Find (or claim) the calling task's ring; nullptr once every slot is taken
+    TaskRing *ring_for_current_task()
+    {
+      TaskHandle_t self = xTaskGetCurrentTaskHandle();
+      for (auto &ring : rings)
+      {
+        TaskHandle_t owner = ring.task.load(std::memory_order_acquire);
+        if (owner == self)
+        {
+          return &ring;
+        }
+
+        if ((owner == nullptr) && ring.task.compare_exchange_strong(owner, self))
+        {
+          return &ring;
+        }
+      }
+      return nullptr;
+    }
+
+    inline void push(const char *name, const char *label, bool begin)
+    {
+      TaskRing *ring = ring_for_current_task();
+      if (!ring)
+      {
+        return;
+      }
+
+      SpanRecord &r = ring->records[ring->head % ESP32_UI_SPAN_EVENTS];
+      r.name = name;
+      r.label = label;
+      r.ts_us = micros();
+      r.begin = begin;
+      ++ring->head;
+    }
+
+    // Labels are user strings; keep the JSON valid if one has a quote in it
+    void print_json_string(Print &out, const char *s)
+    {
+      out.print('"');
+      for (; s && *s; ++s)
+      {
+        if ((*s == '"') || (*s == '\\'))
+        {
+          out.print('\\');
+        }
+        if (static_cast<uint8_t>(*s) >= 0x20)
+        {
+          out.print(*s);
+        }
+      }
+      out.print('"');
+    }
+  } // namespace
+
+  void SpanTrace::begin(const char *name, const char *label)
+  {
+    push(name, label, true);
+  }
+
+  void SpanTrace::end(const char *name, const char *label)
+  {
+    push(name, label, false);
+  }
+
+  void SpanTrace::clear()
+  {
+    for (auto &ring : rings)
+    {
+      ring.head = 0;
+    }
+  }
+
+  void SpanTrace::dump_chrome_json(Print &out)
+  {
+    bool first = true;
+    out.print("{\"traceEvents\":[");
+
+    for (uint8_t tid = 0; tid < ESP32_UI_SPAN_TASKS; ++tid)
+    {
+      TaskRing &ring = rings[tid];
+      TaskHandle_t task = ring.task.load(std::memory_order_acquire);
+      if (!task)
+      {
+        continue;
+      }
+
+      out.printf("%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",", tid);
+      print_json_string(out, pcTaskGetName(task));
+      out.print("}}");
+      first = false;
+
+      const uint32_t head = ring.head;
+      const uint32_t count = (head < ESP32_UI_SPAN_EVENTS) ? head : ESP32_UI_SPAN_EVENTS;
+      for (uint32_t i = head - count; i != head; ++i)
+      {
+        const SpanRecord &r = ring.records[i % ESP32_UI_SPAN_EVENTS];
+        out.print(",\n{\"name\":");
+        print_json_string(out, r.name);
+        out.printf(",\"cat\":\"ui\",\"ph\":\"%c\",\"ts\":%lu,\"pid\":1,\"tid\":%u",
+                   r.begin ? 'B' : 'E',
+                   static_cast<unsigned long>(r.ts_us),
+                   tid);
+        if (r.begin && r.label)
+        {
+          out.print(",\"args\":{\"node\":");
+          print_json_string(out, r.label);
+          out.print("}");
+        }
+        out.print("}");
+      }
+    }
+
+    out.print("\n]}\n");
+  }
+
+} // namespace esp32_ui
+
+#endif
@@ -1,4 +1,7 @@
+#include <atomic>
+#if defined(DISPLAY_BASE)
 #include <U8g2lib.h>
+#endif
 #include <freertos/task.h>
 
 #include <esp32_ui/field.h>
@@ -7,22 +10,38 @@
 #include <esp32_ui/ui_manager.h>
 #include <esp32_ui/event_router.h>
 #include <esp32_ui/toggle_element.h>
+#include <esp32_ui/span_trace.h>
+#include <esp32_ui/display_registry.h>
+#include <esp32_ui/commit_batch.h>
+#include <esp32_ui/event_lanes.h>
+#include <esp32_ui/budget.h>
+#include <esp32_ui/layout.h>
 
 namespace esp32_ui
 {
-  static bool dirty_screen;
+  namespace
+  {
+    // Budget overruns are filed under the node doing the work, if there is one
+    [[maybe_unused]] const char *budget_label(const Element *node, const char *fallback)
+    {
+      return node ? node->label : fallback;
+    }
+  } // namespace
 
   TaskHandle_t ui_task_handle = nullptr;
   UIState *MenuBase::ui_state = nullptr;
 
   TaskHandle_t evt_dispatch_task_handle = nullptr;
-  QueueHandle_t evt_queue = nullptr;
 
-  bool sync_pending = false;
-  bool redraw_pending = false;
+  std::atomic<bool> sync_pending{false};
+  std::atomic<bool> redraw_pending{false};
+
+  EventTraceRecorder *UIManager::trace_recorder = nullptr;
 
   UIManager::UIManager(std::unique_ptr<Canvas> root)
+      : main_port(*Display::instance(), "main")
   {
+    DisplayRegistry::instance()->set_primary(&main_port);
     ui_state = UIState::instance();
     MenuBase::ui_state = ui_state;
     root_node = std::move(root);
@@ -33,26 +52,48 @@ namespace esp32_ui
 
   void UIManager::request_sync()
   {
-    // Tell all the active elements that they need to sync their data
-    sync_pending |= true;
+    // Tell all the active elements that they need to sync their data, and every
+    // other menu level that it has to re-sync when it's returned to
+    MenuStack::bump_sync_generation();
+    request_local_sync();
+  }
+
+  void UIManager::request_local_sync()
+  {
+    sync_pending.store(true);
   }
 
   void UIManager::request_redraw()
   {
-    redraw_pending |= true;
+    redraw_pending.store(true);
+    DisplayRegistry::instance()->mark_all_dirty();
+  }
+
+  bool UIManager::consume_sync_request()
+  {
+    return sync_pending.exchange(false);
   }
 
   void UIManager::dispatch_event(MenuEvent ev)
   {
-    if (evt_queue == nullptr)
+    if (!ev.timestamp_ms)
     {
-      return;
+      ev.timestamp_ms = millis();
+    }
+
+    if (trace_recorder)
+    {
+      trace_recorder->record(ev, micros());
     }
 
-    if (xQueueSend(evt_queue, &ev, 0) != pdPASS)
+    // Bound clock/trigger inputs skip the queue, so UI traffic can't delay them
+    if (EventRouter::instance()->dispatch_realtime(ev))
     {
-      // increment drop counter
+      return;
     }
+
+    // Drops are counted per lane (EventLanes::stats())
+    EventLanes::instance()->push(ev);
   }
 
   void evt_dispatch_task(void * param)
@@ -60,36 +101,57 @@ namespace esp32_ui
     esp32_ui::TaskHeartbeat *hb = esp32_ui::register_task("evt dispatch");
     assert(hb && "whoops, max tasks registered");
 
-    if (evt_queue == nullptr)
-    {
-      // Hey, look! If you generate a bunch of events and it crashes everything, you'll want to
-      // either embiggen this or generate fewer events
-      evt_queue = xQueueCreate(16, sizeof(MenuEvent));
-    }
+    // Hey, look! If you generate a bunch of events and it crashes everything, you'll want to
+    // either embiggen the lanes (EventLanes::configure()) or generate fewer events
+    EventLanes *lanes = EventLanes::instance();
+    lanes->start();
 
     MenuEvent ev;
     auto router = EventRouter::instance();
 
+    // One event through the router, timed against the Dispatch budget
+    auto dispatch_timed = [router](const MenuEvent &ev)
+    {
+#ifdef ESP32_UI_EXEC_BUDGETS
+      ExecBudget::set_current_event(ev);
+#endif
+      UI_BUDGET(Dispatch, budget_label(router->top_menu(), event_type_to_str(ev.type)));
+      router->dispatch(ev);
+    };
+
     //dbprintln("evt_dispatch_task started");
     Serial.println("evt dispatch started");
 
     while(true)
     {
-      if (pdTRUE ==
-        xQueueReceive(evt_queue, (void *)&ev, 1))
+      if (lanes->pop(ev, 1))
       {
         hb_start(hb);
         hb_label(hb, "queued evt");
-        router->dispatch(ev);
+        {
+          // Everything already queued is one batch: commits reach the application
+          // together when the transaction closes (if a batch handler is registered).
+          // Events that arrive meanwhile wait for the next batch, so steady encoder
+          // traffic can't hold the transaction open.
+          CommitTransaction txn;
+          dispatch_timed(ev);
+          for (size_t n = lanes->pending(); n && lanes->pop(ev, 0); --n)
+          {
+            dispatch_timed(ev);
+          }
+        }
         hb_end(hb);
       }
-      else if (sync_pending)
+      else if (sync_pending.exchange(false))
       {
+        // Cleared before dispatching, so a request made during the sync isn't lost
         hb_start(hb);
         hb_label(hb, "sync");
-        router->dispatch({MenuEvent::Source::System, MenuEvent::Type::Sync, 0});
+        {
+          UI_BUDGET(Sync, budget_label(router->top_menu(), "sync"));
+          router->dispatch({MenuEvent::Source::System, MenuEvent::Type::Sync, 0});
+        }
         hb_end(hb);
-        sync_pending = false;
       }
       else
       {
@@ -101,7 +163,7 @@ namespace esp32_ui
 
   void UIManager::schedule_redraw()
   {
-    dirty_screen = true;
+    DisplayRegistry::instance()->mark_menus_dirty();
     // dispatch_event(MenuEvent{MenuEvent::Source::System, MenuEvent::Type::Draw, 0});
   }
 
@@ -118,34 +180,63 @@ namespace esp32_ui
     schedule_redraw();
 
     auto *d = Display::instance();
-    if (d)
-    {
-      d->start_display();
-    }
+    auto *displays = DisplayRegistry::instance();
+    displays->begin_menus();
+    // start_display() sets the font
+    Layout::invalidate_all();
 
     vTaskDelay(100);
 
     while(1)
     {
+      bool sent = false;
+      const TickType_t now = xTaskGetTickCount();
       hb_start(hb);
       if (!ui->root_node->is_schleep())
       {
+        ui->saver_engine.stop();
         schedule_redraw();
       }
+      else if (!Display::page_buffered && ui->saver_engine.has_effects())
+      {
+        // The engine renders straight into the buffer and decides whether there's
+        // anything new to send, so skip the menu draw entirely
+        hb_label(hb, "screen saver");
+        if (ui->saver_engine.tick(d))
+        {
+          UI_SPAN("sendBuffer", "screen saver");
+          d->sendBuffer();
+          sent = true;
+        }
+        ui->main_port.take_dirty();
+      }
       else
       {
         ui->screen_saver();
         schedule_redraw();
       }
 
-      if (dirty_screen)
+      if (ui->main_port.take_frame(now))
       {
-        d->clearBuffer();
-        EventRouter::instance()->top_menu()->handle_draw(d);
-        d->sendBuffer();
+        UI_BUDGET(Draw, budget_label(ui->main_port.shown(), "draw"));
+        ui->main_port.draw_frame();
+        sent = true;
+      }
 
-        dirty_screen = false;
+      if (ui->mirror)
+      {
+        // A page buffer only holds the last page; there's no frame to mirror
+        if (sent && !Display::page_buffered)
+        {
+          ui->mirror->publish(d);
+        }
+        ui->mirror->poll_input();
       }
+
+      // Any other panels showing the menu tree. Last, because a panel with the same
+      // driver type overwrites U8g2's static buffer, which still held the primary's
+      // frame (menu or screen saver) up to here
+      displays->draw_menus();
       hb_end(hb);
 
       xTaskDelayUntil(&xLastWakeTime, xTaskFrequency);
@@ -185,7 +276,10 @@ namespace esp32_ui
       // pcTaskGetName(xHandle);
 
       hb_start(hb);
-      dirty_screen |= ui->update();
+      if (ui->update())
+      {
+        schedule_redraw();
+      }
 
       // if (!display_refresh_timer)
       // {
@@ -197,7 +291,7 @@ namespace esp32_ui
 
   void UIManager::start_ui()
   {
-    dirty_screen = true;
+    schedule_redraw();
     start_heartbeat();
     vTaskDelay(1000);
 
@@ -226,6 +320,9 @@ namespace esp32_ui
       this,
       1,
       &evt_dispatch_task_handle);
+
+    // Raw panels get a render task each; menu panels are drawn by display_task
+    DisplayRegistry::instance()->start();
   }
 
 } // namespace esp32_ui
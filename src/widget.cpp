@@ -1,6 +1,9 @@
+#include <algorithm>
 #include <esp32_ui/widget.h>
 #include <esp32_ui/canvas.h>
 #include <esp32_ui/event_router.h>
+#include <esp32_ui/font_metrics.h>
+#include <esp32_ui/span_trace.h>
 
 namespace esp32_ui
 {
@@ -26,11 +29,13 @@ namespace esp32_ui
   {
     assert(submenu->base_type() == BaseType::Canvas);
     linked_canvas = std::move(submenu);
+    layout_stamp.invalidate();
   }
 
   void Widget::add_element(std::unique_ptr<Element> element)
   {
     elements.push_back(std::move(element));
+    layout_stamp.invalidate();
   }
 
   bool Widget::handle_event(const MenuEvent &ev)
@@ -139,7 +144,7 @@ namespace esp32_ui
   void Widget::highlight_if_active(Display *d) const
   {
     d->setCursor(0, d->getCursorY());
-    if (is_active)
+    if (is_active && !ui_state->invert_highlight())
     {
       d->print(">");
     }
@@ -149,9 +154,32 @@ namespace esp32_ui
     }
   }
 
+  void Widget::update_layout(Display *d) const
+  {
+    layout_stamp.mark_current();
+
+    // The label starts after the wider of the two highlight glyphs, so it doesn't
+    // shift when the row gains focus
+    auto *fm = FontMetrics::instance();
+    const uint8_t marker_w = std::max(fm->advance(d, '>'), fm->advance(d, ' '));
+    columns.label_x = marker_w;
+
+    const Element *el = c_selected_element();
+    const uint16_t label_end = marker_w + (el ? fm->text_width(d, el->label) : 0);
+    columns.value_x = (label_end < cursor_offset) ? cursor_offset : std::min<uint16_t>(label_end, UINT8_MAX);
+  }
+
   void Widget::handle_draw(Display *d) const
   {
+    UI_SPAN("Widget::handle_draw", label);
+    if (layout_stamp.is_stale())
+    {
+      update_layout(d);
+    }
+
+    const uint8_t y = d->getCursorY();
     highlight_if_active(d);
+    d->setCursor(columns.label_x, y);
     if (linked_canvas)
     {
       d->print(linked_canvas->label);
@@ -162,12 +190,7 @@ namespace esp32_ui
       if (el)
       {
         el->print_label(d);
-        uint8_t ofs = d->getCursorX();
-        if (ofs < cursor_offset)
-        {
-          ofs = cursor_offset;
-        }
-        d->setCursor(ofs, d->getCursorY());
+        d->setCursor(columns.value_x, y);
         d->print(":");
 
         if (is_editing)
@@ -192,6 +215,7 @@ namespace esp32_ui
 
   bool Widget::can_handle(const MenuEvent &ev) const
   {
+    UI_SPAN("Widget::can_handle", label);
     menuprintf("Widget::can_handle?");
     print_event(ev);
     // Check if individual element filters out specific event
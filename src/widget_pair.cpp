@@ -1,5 +1,8 @@
+#include <algorithm>
 #include <esp32_ui/widget_pair.h>
 #include <esp32_ui/event_router.h>
+#include <esp32_ui/font_metrics.h>
+#include <esp32_ui/span_trace.h>
 
 #ifndef LEFT_ENCODER_INDEX
 #define LEFT_ENCODER_INDEX 0
@@ -121,27 +124,45 @@ namespace esp32_ui
     return MenuBase::handle_nav_delta(ev);
   }
 
+  void WidgetPair::update_layout(Display *d) const
+  {
+    layout_stamp.mark_current();
+
+    // Room for whichever of '[' and ' ' gets printed in front of the pair
+    auto *fm = FontMetrics::instance();
+    const uint8_t margin = std::max(fm->advance(d, '['), fm->advance(d, ' '));
+    pair_columns.left_x = margin;
+    pair_columns.right_x = d->half_width() + margin;
+    pair_columns.close_x = d->getWidth() - fm->advance(d, ']');
+  }
+
   void WidgetPair::handle_draw(Display *d) const
   {
+    UI_SPAN("WidgetPair::handle_draw", label);
+    if (layout_stamp.is_stale())
+    {
+      update_layout(d);
+    }
+
     const uint8_t y = d->getCursorY();
-    auto margin = d->char_width();
+    const bool show_brackets = is_active && !ui_state->invert_highlight();
 
     d->setCursor(0, y);
-    d->print(is_active ? "[" : " ");
+    d->print(show_brackets ? "[" : " ");
 
-    d->setCursor(margin, y);
+    d->setCursor(pair_columns.left_x, y);
     c_left()->print_label(d);
     d->print(": ");
     c_left()->print_value(d);
 
-    d->setCursor(d->half_width() + margin, y);
+    d->setCursor(pair_columns.right_x, y);
     c_right()->print_label(d);
     d->print(": ");
     c_right()->print_value(d);
 
-    if (is_active)
+    if (show_brackets)
     {
-      d->setCursor(d->getWidth() - d->char_width(), y);
+      d->setCursor(pair_columns.close_x, y);
       d->print("]");
     }
   }